@@ -9,6 +9,8 @@
 #include <nds.h>
 #include <maxmod7.h>
 
+#include "ndsntp_fifo.h"
+
 volatile bool exit_loop = false;
 
 void power_button_callback(void)
@@ -22,20 +24,74 @@ void vblank_handler(void)
     Wifi_Update();
 }
 
+// Timer 0 is used by Maxmod and timer 3 by the clock
+#define RTC_WRITE_TIMER 1
+
+static struct NdsntpRtcRequest rtc_request;
+static volatile bool rtc_request_pending = false;
+
+static void rtc_send_reply(uint32_t seq, uint8_t status)
+{
+    struct NdsntpRtcReply reply = { .seq = seq, .status = status };
+    rtcTimeAndDateGet(&reply.readback);
+    fifoSendDatamsg(FIFO_NDSNTP, sizeof(reply), (void *)&reply);
+}
+
+// Writes the scheduled date. Runs from the timer interrupt, at the moment the
+// ARM9 asked for: the second edge of the date being written.
+static void rtc_commit(void)
+{
+    timerStop(RTC_WRITE_TIMER);
+
+    uint8_t status = NDSNTP_RTC_OK;
+    if (rtcTimeAndDateSet(&rtc_request.time) != 0)
+        status = NDSNTP_RTC_WRITE_FAILED;
+
+    // Restart the second tick here, which also rereads the RTC. From now on
+    // time() on both CPUs turns over when the RTC does, instead of wherever
+    // the old tick happened to be.
+    initClockIRQTimer(3);
+
+    rtc_request_pending = false;
+    rtc_send_reply(rtc_request.seq, status);
+}
+
 void fifo_handler_datamsg_time_date(int num_bytes, void *userdata)
 {
-    rtcTimeAndDate rtc_time_date;
-    fifoGetDatamsg(FIFO_USER_01, sizeof(rtc_time_date), (void *)&rtc_time_date);
+    struct NdsntpRtcRequest request;
 
-    uint32_t ok = 0;
+    if (num_bytes != sizeof(request))
+    {
+        // Take the message out of the queue anyway, or it blocks the channel
+        uint8_t discard[FIFO_MAX_DATA_BYTES];
+        fifoGetDatamsg(FIFO_NDSNTP, sizeof(discard), discard);
+        rtc_send_reply(0, NDSNTP_RTC_BAD_REQUEST);
+        return;
+    }
 
-    if (rtcTimeAndDateSet(&rtc_time_date) == 0)
-        ok = 1;
+    fifoGetDatamsg(FIFO_NDSNTP, sizeof(request), (void *)&request);
 
-    // Read the RTC to get the new date instead of assuming the write succeeded
-    resyncClock();
+    if (request.delayUs > NDSNTP_RTC_MAX_DELAY_US)
+    {
+        rtc_send_reply(request.seq, NDSNTP_RTC_BAD_REQUEST);
+        return;
+    }
+    if (rtc_request_pending)
+    {
+        rtc_send_reply(request.seq, NDSNTP_RTC_BUSY);
+        return;
+    }
 
-    fifoSendValue32(FIFO_USER_01, ok);
+    rtc_request = request;
+    rtc_request_pending = true;
+
+    // The timer counts up from the reload value and fires when it overflows
+    uint32_t ticks = (uint64_t)request.delayUs * BUS_CLOCK / (1024 * 1000000ULL);
+    if (ticks == 0)
+        rtc_commit();
+    else
+        timerStart(RTC_WRITE_TIMER, ClockDivider_1024, (u16)(0x10000 - ticks),
+                   rtc_commit);
 }
 
 void fifo_handler_datamsg_time(int num_bytes, void *userdata)
@@ -97,7 +153,7 @@ int main(int argc, char *argv[])
     irqEnable(IRQ_VBLANK);
 
     // This channel will listen to messages from the ARM9 with a time and date
-    fifoSetDatamsgHandler(FIFO_USER_01, fifo_handler_datamsg_time_date, NULL);
+    fifoSetDatamsgHandler(FIFO_NDSNTP, fifo_handler_datamsg_time_date, NULL);
     // This one will only change the time
     fifoSetDatamsgHandler(FIFO_USER_02, fifo_handler_datamsg_time, NULL);
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdio.h>
+#include <string.h>
+#include "core_sntp_config.h"
+#include "addrcache.h"
+#include "drift.h"
+#include "storage.h"
+
+#define ADDRCACHE_MAGIC     0x4350544e      /* "NTPC" */
+#define ADDRCACHE_VERSION   2      /* 2: expiry in UTC rather than RTC time */
+
+struct AddrCacheHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t numOfEntries;
+};
+
+static struct AddrCacheEntry addrcache[ADDRCACHE_MAX_ENTRIES];
+static bool addrcacheDirty = false;
+static uint32_t addrcacheMinTtl = 0;
+
+/* UTC, so that changing the zone (which moves the RTC) doesn't move expiry. */
+static int64_t addrcacheNow(void)
+{
+    return (int64_t)time(NULL) - driftRtcOffsetSec();
+}
+
+static struct AddrCacheEntry * addrcacheFind(const char * name)
+{
+    for(size_t i=0; i<ADDRCACHE_MAX_ENTRIES; i++) {
+        if(addrcache[i].numOfAddrs != 0 &&
+           strncmp(addrcache[i].name, name, DNS_MAX_NAME) == 0)
+            return &addrcache[i];
+    }
+    return NULL;
+}
+
+void addrcacheLoad(void)
+{
+    FILE * f = storageOpen(ADDRCACHE_FILE, "rb");
+    if(f == NULL)
+        return;
+
+    struct AddrCacheHeader header;
+    if(fread(&header, sizeof(header), 1, f) != 1 ||
+       header.magic != ADDRCACHE_MAGIC ||
+       header.version != ADDRCACHE_VERSION) {
+        LogWarn(("Ignoring unreadable address cache."));
+        fclose(f);
+        return;
+    }
+
+    int64_t now = addrcacheNow();
+    size_t n = 0;
+    struct AddrCacheEntry entry;
+    for(size_t i=0; i<header.numOfEntries && n<ADDRCACHE_MAX_ENTRIES; i++) {
+        if(fread(&entry, sizeof(entry), 1, f) != 1)
+            break;
+        if(entry.expires <= now || entry.numOfAddrs == 0 ||
+           entry.numOfAddrs > DNS_MAX_RECORDS)
+            continue;
+        entry.name[DNS_MAX_NAME-1] = '\0';
+        addrcache[n++] = entry;
+    }
+    fclose(f);
+    LogDebug(("Loaded %u cached addresses.", (unsigned)n));
+}
+
+bool addrcacheSave(void)
+{
+    if(!addrcacheDirty)
+        return true;
+
+    FILE * f = storageOpen(ADDRCACHE_FILE, "wb");
+    if(f == NULL)
+        return false;
+
+    struct AddrCacheHeader header = {
+        .magic = ADDRCACHE_MAGIC,
+        .version = ADDRCACHE_VERSION,
+        .numOfEntries = 0,
+    };
+    for(size_t i=0; i<ADDRCACHE_MAX_ENTRIES; i++) {
+        if(addrcache[i].numOfAddrs != 0)
+            header.numOfEntries++;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    for(size_t i=0; ok && i<ADDRCACHE_MAX_ENTRIES; i++) {
+        if(addrcache[i].numOfAddrs != 0)
+            ok = fwrite(&addrcache[i], sizeof(addrcache[i]), 1, f) == 1;
+    }
+    if(fclose(f) != 0)
+        ok = false;
+    if(!ok) {
+        LogWarn(("Could not save the address cache."));
+        return false;
+    }
+    addrcacheDirty = false;
+    return true;
+}
+
+void addrcacheSetMinTtl(uint32_t seconds)
+{
+    addrcacheMinTtl = seconds;
+}
+
+void addrcacheStore(const char * name,
+                    const struct DnsRecord * pRecords,
+                    size_t numOfRecords)
+{
+    if(numOfRecords == 0)
+        return;
+
+    struct AddrCacheEntry * pEntry = addrcacheFind(name);
+    if(pEntry == NULL) {
+        /* Take a free slot, or evict the entry that expires first. */
+        pEntry = &addrcache[0];
+        for(size_t i=0; i<ADDRCACHE_MAX_ENTRIES; i++) {
+            if(addrcache[i].numOfAddrs == 0) {
+                pEntry = &addrcache[i];
+                break;
+            }
+            if(addrcache[i].expires < pEntry->expires)
+                pEntry = &addrcache[i];
+        }
+    }
+
+    uint32_t ttl = UINT32_MAX;
+    if(numOfRecords > DNS_MAX_RECORDS)
+        numOfRecords = DNS_MAX_RECORDS;
+    memset(pEntry, 0, sizeof(*pEntry));
+    strncpy(pEntry->name, name, DNS_MAX_NAME - 1);
+    for(size_t i=0; i<numOfRecords; i++) {
+        pEntry->addrs[i] = pRecords[i].addr;
+        if(pRecords[i].ttl < ttl) ttl = pRecords[i].ttl;
+    }
+    pEntry->numOfAddrs = numOfRecords;
+    if(ttl < addrcacheMinTtl)
+        ttl = addrcacheMinTtl;
+    pEntry->expires = addrcacheNow() + ttl;
+    addrcacheDirty = true;
+}
+
+size_t addrcacheLookup(const char * name,
+                       struct DnsRecord * pRecords,
+                       size_t max)
+{
+    const struct AddrCacheEntry * pEntry = addrcacheFind(name);
+    int64_t now = addrcacheNow();
+    if(pEntry == NULL || pEntry->expires <= now)
+        return 0;
+
+    size_t n = 0;
+    for(; n<pEntry->numOfAddrs && n<max; n++) {
+        pRecords[n].addr = pEntry->addrs[n];
+        pRecords[n].ttl = pEntry->expires - now;
+    }
+    return n;
+}
+
+void addrcacheDrop(const char * name, uint32_t addr)
+{
+    struct AddrCacheEntry * pEntry = addrcacheFind(name);
+    if(pEntry == NULL)
+        return;
+
+    for(size_t i=0; i<pEntry->numOfAddrs; i++) {
+        if(pEntry->addrs[i] != addr)
+            continue;
+        memmove(&pEntry->addrs[i], &pEntry->addrs[i+1],
+                (pEntry->numOfAddrs - i - 1) * sizeof(pEntry->addrs[0]));
+        pEntry->numOfAddrs--;   // An entry with no addresses is a free slot
+        addrcacheDirty = true;
+        return;
+    }
+}
@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <nds.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include "auth.h"
+
+#define AUTH_BLOCK_SIZE     64
+#define AUTH_MAX_BLOCKS     2       /* Key, packet and padding always fit */
+#define AUTH_MAX_ASCII_KEY  20      /* Longer secrets are hex, as in ntpd */
+
+#define ROL(x, n)           ((uint32_t)((x) << (n)) | ((x) >> (32 - (n))))
+
+static struct {
+    enum AuthType type;
+    uint32_t keyId;
+    size_t keyLength;
+    size_t digestSize;
+    size_t numOfBlocks;
+    /* key || packet || 0x80 || zeros || length in bits. Only the packet
+     * changes from one MAC to the next. */
+    uint8_t blocks[AUTH_MAX_BLOCKS * AUTH_BLOCK_SIZE] __attribute__((aligned(4)));
+} auth = { .type = AUTH_NONE };
+
+/* One MD5 step; f is the round's mixing function. */
+#define MD5_STEP(f, a, b, c, d, m, k, s) \
+    do { (a) += f(b, c, d) + (m) + (k); (a) = ROL(a, s) + (b); } while(0)
+#define MD5_F(x, y, z)      ((z) ^ ((x) & ((y) ^ (z))))
+#define MD5_G(x, y, z)      ((y) ^ ((z) & ((x) ^ (y))))
+#define MD5_H(x, y, z)      ((x) ^ (y) ^ (z))
+#define MD5_I(x, y, z)      ((y) ^ ((x) | ~(z)))
+
+/* Twenty SHA-1 steps with the same function, so no step has to pick one. */
+#define SHA1_ROUND(first, f, k)                                               \
+    for(int i=(first); i<(first)+20; i++) {                                   \
+        if(i >= 16)                                                           \
+            w[i & 15] = ROL(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^              \
+                            w[(i + 2) & 15] ^ w[i & 15], 1);                  \
+        uint32_t t = ROL(a, 5) + (f) + (k) + e + w[i & 15];                   \
+        e = d;                                                                \
+        d = c;                                                                \
+        c = ROL(b, 30);                                                       \
+        b = a;                                                                \
+        a = t;                                                                \
+    }
+
+static uint32_t loadLe32(const uint8_t * p)
+{
+    return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint32_t loadBe32(const uint8_t * p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static void storeBe32(uint8_t * p, uint32_t x)
+{
+    p[0] = x >> 24;
+    p[1] = x >> 16;
+    p[2] = x >> 8;
+    p[3] = x;
+}
+
+/* The two compression functions run for every packet sent and received, so
+ * they live in ITCM, away from the cache and the bus. */
+ITCM_CODE static void md5Compress(uint32_t * pState, const uint8_t * pBlock)
+{
+    uint32_t m[16];
+    for(int i=0; i<16; i++)
+        m[i] = loadLe32(pBlock + 4 * i);
+
+    uint32_t a = pState[0], b = pState[1], c = pState[2], d = pState[3];
+
+    MD5_STEP(MD5_F, a, b, c, d, m[0],  0xd76aa478, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[1],  0xe8c7b756, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[2],  0x242070db, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[3],  0xc1bdceee, 22);
+    MD5_STEP(MD5_F, a, b, c, d, m[4],  0xf57c0faf, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[5],  0x4787c62a, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[6],  0xa8304613, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[7],  0xfd469501, 22);
+    MD5_STEP(MD5_F, a, b, c, d, m[8],  0x698098d8, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[9],  0x8b44f7af, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[10], 0xffff5bb1, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[11], 0x895cd7be, 22);
+    MD5_STEP(MD5_F, a, b, c, d, m[12], 0x6b901122, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[13], 0xfd987193, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[14], 0xa679438e, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[15], 0x49b40821, 22);
+
+    MD5_STEP(MD5_G, a, b, c, d, m[1],  0xf61e2562, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[6],  0xc040b340, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[11], 0x265e5a51, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[0],  0xe9b6c7aa, 20);
+    MD5_STEP(MD5_G, a, b, c, d, m[5],  0xd62f105d, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[10], 0x02441453, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[15], 0xd8a1e681, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[4],  0xe7d3fbc8, 20);
+    MD5_STEP(MD5_G, a, b, c, d, m[9],  0x21e1cde6, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[14], 0xc33707d6, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[3],  0xf4d50d87, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[8],  0x455a14ed, 20);
+    MD5_STEP(MD5_G, a, b, c, d, m[13], 0xa9e3e905, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[2],  0xfcefa3f8, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[7],  0x676f02d9, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[12], 0x8d2a4c8a, 20);
+
+    MD5_STEP(MD5_H, a, b, c, d, m[5],  0xfffa3942, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[8],  0x8771f681, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[11], 0x6d9d6122, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[14], 0xfde5380c, 23);
+    MD5_STEP(MD5_H, a, b, c, d, m[1],  0xa4beea44, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[4],  0x4bdecfa9, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[7],  0xf6bb4b60, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[10], 0xbebfbc70, 23);
+    MD5_STEP(MD5_H, a, b, c, d, m[13], 0x289b7ec6, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[0],  0xeaa127fa, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[3],  0xd4ef3085, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[6],  0x04881d05, 23);
+    MD5_STEP(MD5_H, a, b, c, d, m[9],  0xd9d4d039, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[12], 0xe6db99e5, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[15], 0x1fa27cf8, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[2],  0xc4ac5665, 23);
+
+    MD5_STEP(MD5_I, a, b, c, d, m[0],  0xf4292244, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[7],  0x432aff97, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[14], 0xab9423a7, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[5],  0xfc93a039, 21);
+    MD5_STEP(MD5_I, a, b, c, d, m[12], 0x655b59c3, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[3],  0x8f0ccc92, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[10], 0xffeff47d, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[1],  0x85845dd1, 21);
+    MD5_STEP(MD5_I, a, b, c, d, m[8],  0x6fa87e4f, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[15], 0xfe2ce6e0, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[6],  0xa3014314, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[13], 0x4e0811a1, 21);
+    MD5_STEP(MD5_I, a, b, c, d, m[4],  0xf7537e82, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[11], 0xbd3af235, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[2],  0x2ad7d2bb, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[9],  0xeb86d391, 21);
+
+    pState[0] += a;
+    pState[1] += b;
+    pState[2] += c;
+    pState[3] += d;
+}
+
+ITCM_CODE static void sha1Compress(uint32_t * pState, const uint8_t * pBlock)
+{
+    /* The message schedule only ever looks 16 words back. */
+    uint32_t w[16];
+    for(int i=0; i<16; i++)
+        w[i] = loadBe32(pBlock + 4 * i);
+
+    uint32_t a = pState[0], b = pState[1], c = pState[2], d = pState[3],
+             e = pState[4];
+
+    SHA1_ROUND(0,  d ^ (b & (c ^ d)),          0x5a827999)
+    SHA1_ROUND(20, b ^ c ^ d,                  0x6ed9eba1)
+    SHA1_ROUND(40, (b & c) | (d & (b | c)),    0x8f1bbcdc)
+    SHA1_ROUND(60, b ^ c ^ d,                  0xca62c1d6)
+
+    pState[0] += a;
+    pState[1] += b;
+    pState[2] += c;
+    pState[3] += d;
+    pState[4] += e;
+}
+
+/* Hashes the key and the first 48 bytes at `pPacket` into `pDigest`. */
+ITCM_CODE static void authDigest(const uint8_t * pPacket, uint8_t * pDigest)
+{
+    memcpy(auth.blocks + auth.keyLength, pPacket, SNTP_PACKET_BASE_SIZE);
+
+    if(auth.type == AUTH_MD5) {
+        uint32_t state[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+        for(size_t i=0; i<auth.numOfBlocks; i++)
+            md5Compress(state, auth.blocks + i * AUTH_BLOCK_SIZE);
+        for(int i=0; i<4; i++) {
+            uint32_t x = state[i];
+            for(int j=0; j<4; j++, x >>= 8)
+                pDigest[4 * i + j] = x;
+        }
+    }
+    else {
+        uint32_t state[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476,
+                              0xc3d2e1f0 };
+        for(size_t i=0; i<auth.numOfBlocks; i++)
+            sha1Compress(state, auth.blocks + i * AUTH_BLOCK_SIZE);
+        for(int i=0; i<5; i++)
+            storeBe32(pDigest + 4 * i, state[i]);
+    }
+}
+
+bool authSetKey(uint32_t keyId, enum AuthType type,
+                const uint8_t * pKey, size_t keyLength)
+{
+    if(type == AUTH_NONE) {
+        auth.type = AUTH_NONE;
+        return true;
+    }
+    if(keyLength == 0 || keyLength > AUTH_MAX_KEY_SIZE || keyId == 0)
+        return false;
+
+    auth.type = type;
+    auth.keyId = keyId;
+    auth.keyLength = keyLength;
+    auth.digestSize = type == AUTH_MD5 ? 16 : 20;
+
+    size_t length = keyLength + SNTP_PACKET_BASE_SIZE;
+    auth.numOfBlocks = (length + 1 + 8 + AUTH_BLOCK_SIZE - 1) / AUTH_BLOCK_SIZE;
+    size_t end = auth.numOfBlocks * AUTH_BLOCK_SIZE;
+    memset(auth.blocks, 0, sizeof(auth.blocks));
+    memcpy(auth.blocks, pKey, keyLength);
+    auth.blocks[length] = 0x80;
+
+    /* MD5 stores the length little-endian, SHA-1 big-endian. */
+    uint64_t bits = (uint64_t)length * 8;
+    for(int i=0; i<8; i++) {
+        uint8_t byte = bits >> (8 * i);
+        if(type == AUTH_MD5)
+            auth.blocks[end - 8 + i] = byte;
+        else
+            auth.blocks[end - 1 - i] = byte;
+    }
+    return true;
+}
+
+bool authParseKey(const char * spec)
+{
+    uint32_t keyId;
+    char typeName[8], secret[2 * AUTH_MAX_KEY_SIZE + 2];
+    uint8_t key[AUTH_MAX_KEY_SIZE];
+    size_t keyLength;
+    enum AuthType type;
+
+    if(sscanf(spec, "%" SCNu32 " %7s %65s", &keyId, typeName, secret) != 3)
+        return false;
+    if(!strcasecmp(typeName, "MD5") || !strcasecmp(typeName, "M"))
+        type = AUTH_MD5;
+    else if(!strcasecmp(typeName, "SHA1") || !strcasecmp(typeName, "SHA"))
+        type = AUTH_SHA1;
+    else
+        return false;
+
+    keyLength = strlen(secret);
+    if(keyLength <= AUTH_MAX_ASCII_KEY) {
+        memcpy(key, secret, keyLength);
+    }
+    else {
+        if(keyLength % 2 != 0 || keyLength / 2 > AUTH_MAX_KEY_SIZE)
+            return false;
+        keyLength /= 2;
+        for(size_t i=0; i<keyLength; i++) {
+            unsigned int byte;
+            if(!isxdigit((unsigned char)secret[2*i]) ||
+               !isxdigit((unsigned char)secret[2*i+1]) ||
+               sscanf(&secret[2*i], "%2x", &byte) != 1)
+                return false;
+            key[i] = byte;
+        }
+    }
+    return authSetKey(keyId, type, key, keyLength);
+}
+
+bool authEnabled(void)
+{
+    return auth.type != AUTH_NONE;
+}
+
+size_t authSign(uint8_t * pPacket)
+{
+    if(auth.type == AUTH_NONE)
+        return 0;
+    storeBe32(pPacket + SNTP_PACKET_BASE_SIZE, auth.keyId);
+    authDigest(pPacket, pPacket + SNTP_PACKET_BASE_SIZE + AUTH_KEY_ID_SIZE);
+    return AUTH_KEY_ID_SIZE + auth.digestSize;
+}
+
+bool authCheck(const uint8_t * pPacket, size_t length)
+{
+    if(auth.type == AUTH_NONE)
+        return true;
+    if(length != SNTP_PACKET_BASE_SIZE + AUTH_KEY_ID_SIZE + auth.digestSize ||
+       loadBe32(pPacket + SNTP_PACKET_BASE_SIZE) != auth.keyId)
+        return false;
+
+    uint8_t digest[AUTH_MAX_DIGEST_SIZE];
+    authDigest(pPacket, digest);
+
+    /* Compare all of it, so the time taken says nothing about where the
+     * first difference is. */
+    const uint8_t * mac = pPacket + SNTP_PACKET_BASE_SIZE + AUTH_KEY_ID_SIZE;
+    uint8_t diff = 0;
+    for(size_t i=0; i<auth.digestSize; i++)
+        diff |= digest[i] ^ mac[i];
+    return diff == 0;
+}
+
+static SntpStatus_t authGenerate(SntpAuthContext_t * pContext,
+                                 const SntpServerInfo_t * pTimeServer,
+                                 void * pBuffer,
+                                 size_t bufferSize,
+                                 uint16_t * pAuthCodeSize)
+{
+    if(bufferSize < AUTH_PACKET_SIZE)
+        return SntpErrorBufferTooSmall;
+    *pAuthCodeSize = authSign(pBuffer);
+    return SntpSuccess;
+}
+
+static SntpStatus_t authValidate(SntpAuthContext_t * pContext,
+                                 const SntpServerInfo_t * pTimeServer,
+                                 const void * pResponseData,
+                                 uint16_t responseSize)
+{
+    return authCheck(pResponseData, responseSize) ? SntpSuccess
+                                                  : SntpServerNotAuthenticated;
+}
+
+const SntpAuthenticationInterface_t * authInterface(void)
+{
+    static const SntpAuthenticationInterface_t intf = {
+        .pAuthContext = NULL,
+        .generateClientAuth = authGenerate,
+        .validateServerAuth = authValidate
+    };
+    return auth.type != AUTH_NONE ? &intf : NULL;
+}
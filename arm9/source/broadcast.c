@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <errno.h>
+#include "broadcast.h"
+#include "core_sntp_config.h"
+
+#define BROADCAST_MODE          5
+/* Datagrams read per poll, in case something floods the port. */
+#define BROADCAST_MAX_READS     8
+
+static uint32_t loadBe32(const uint8_t * p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+bool broadcastOpen(struct Broadcast * pBroadcast, uint16_t port)
+{
+    memset(pBroadcast, 0, sizeof(*pBroadcast));
+    pBroadcast->netContext.udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if(pBroadcast->netContext.udpSocket < 0) {
+        LogError(("Could not open the broadcast socket. Errno was %i", errno));
+        return false;
+    }
+
+    /* Lets a test server on the same host have the port too. */
+    int yes = 1;
+    setsockopt(pBroadcast->netContext.udpSocket, SOL_SOCKET, SO_REUSEADDR,
+               &yes, sizeof(yes));
+
+    struct sockaddr_in addri = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if(bind(pBroadcast->netContext.udpSocket, (struct sockaddr *)&addri,
+            sizeof(addri)) < 0) {
+        LogError(("Could not listen on port %u. Errno was %i", port, errno));
+        broadcastClose(pBroadcast);
+        return false;
+    }
+    return true;
+}
+
+void broadcastListen(struct Broadcast * pBroadcast,
+                     const SntpServerInfo_t * pSource,
+                     uint32_t sourceAddr,
+                     int32_t delayMs,
+                     uint32_t timeoutMs)
+{
+    pBroadcast->pSource = pSource;
+    pBroadcast->sourceAddr = sourceAddr;
+    pBroadcast->delayMs = delayMs;
+    pBroadcast->timeoutMs = timeoutMs;
+    sntpGetTime(&pBroadcast->start);
+}
+
+/* Whether the `length` bytes in the buffer are a broadcast we can set the
+ * clock by. Fills in the response if so. */
+static bool broadcastAccept(struct Broadcast * pBroadcast, size_t length)
+{
+    const uint8_t * p = pBroadcast->buffer;
+    const char * why = NULL;
+
+    uint8_t leap = p[0] >> 6, version = (p[0] >> 3) & 7, mode = p[0] & 7;
+    SntpTimestamp_t txTime = {
+        .seconds = loadBe32(p + 40),
+        .fractions = loadBe32(p + 44)
+    };
+    if(length < SNTP_PACKET_BASE_SIZE)
+        why = "too short";
+    else if(mode != BROADCAST_MODE || version < 3 || version > 4)
+        why = "not a broadcast";
+    else if(leap == AlarmServerNotSynchronized || p[1] == 0 || p[1] > 15)
+        why = "not synchronized";
+    else if(txTime.seconds == 0 && txTime.fractions == 0)
+        why = "no time in it";
+    else if(!authCheck(p, length))
+        why = "failed authentication";
+    if(why != NULL) {
+        LogWarn(("Ignoring a broadcast from %s: %s.",
+                 pBroadcast->pSource->pServerName, why));
+        pBroadcast->numOfRejected++;
+        return false;
+    }
+
+    /* It left at txTime, so it is now txTime plus however long it took. */
+    SntpResponseData_t * r = &pBroadcast->response;
+    r->serverTime = txTime;
+    sntpTimestampAddMs(&r->serverTime, pBroadcast->delayMs);
+    r->clockOffsetMs = sntpTimestampDiffMs(&pBroadcast->rxTime, &r->serverTime);
+    r->leapSecondType = leap;
+    r->rejectedResponseCode = 0;
+    return true;
+}
+
+SntpStatus_t broadcastPoll(struct Broadcast * pBroadcast)
+{
+    /* sntpUdpRecv() connects the socket to the source, so nothing from any
+     * other address or port gets this far. */
+    for(int i=0; i<BROADCAST_MAX_READS; i++) {
+        int32_t r = sntpUdpRecv(&pBroadcast->netContext, pBroadcast->sourceAddr,
+                                pBroadcast->pSource->port, pBroadcast->buffer,
+                                sizeof(pBroadcast->buffer));
+        if(r <= 0)
+            break;
+        sntpGetTime(&pBroadcast->rxTime);
+        if(broadcastAccept(pBroadcast, r))
+            return SntpSuccess;
+    }
+
+    SntpTimestamp_t now;
+    sntpGetTime(&now);
+    if(sntpTimestampDiffMs(&pBroadcast->start, &now) >= pBroadcast->timeoutMs)
+        return SntpErrorResponseTimeout;
+    return SntpNoResponseReceived;
+}
+
+void broadcastClose(struct Broadcast * pBroadcast)
+{
+    if(pBroadcast->netContext.udpSocket >= 0)
+        closesocket(pBroadcast->netContext.udpSocket);
+    pBroadcast->netContext.udpSocket = -1;
+    pBroadcast->netContext.connected = false;
+}
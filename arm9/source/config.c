@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "addrcache.h"
+#include "auth.h"
+#include "config.h"
+#include "core_sntp_config.h"
+#include "storage.h"
+#include "tz.h"
+
+#define CONFIG_LINE_BYTES   160
+
+static struct Config cfg = {
+    .headless = false,
+    .retries = SYNC_DEFAULT_RETRIES,
+};
+
+/* Drops leading and trailing blanks, in place. */
+static char * configTrim(char * s)
+{
+    while(isspace((unsigned char)*s))
+        s++;
+    char * end = s + strlen(s);
+    while(end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+    return s;
+}
+
+static bool configNumber(const char * value, long min, long max, long * pOut)
+{
+    char * end;
+    long n = strtol(value, &end, 10);
+    if(end == value || *end != '\0' || n < min || n > max)
+        return false;
+    *pOut = n;
+    return true;
+}
+
+static bool configBool(const char * value, bool * pOut)
+{
+    if(!strcmp(value, "yes") || !strcmp(value, "true") || !strcmp(value, "1"))
+        *pOut = true;
+    else if(!strcmp(value, "no") || !strcmp(value, "false") || !strcmp(value, "0"))
+        *pOut = false;
+    else
+        return false;
+    return true;
+}
+
+/* "+05:30", "-5", "+0530" */
+static bool configOffset(const char * value, int32_t * pOut)
+{
+    int sign = 1;
+    if(*value == '+' || *value == '-')
+        sign = *value++ == '-' ? -1 : 1;
+
+    char * end;
+    long hours = strtol(value, &end, 10), minutes = 0;
+    if(end == value || hours < 0)
+        return false;
+    if(*end == ':') {
+        const char * m = end + 1;
+        minutes = strtol(m, &end, 10);
+        if(end == m)
+            return false;
+    }
+    else if(end - value == 4) {
+        minutes = hours % 100;
+        hours /= 100;
+    }
+    if(*end != '\0' || hours > 16 || minutes > 59)
+        return false;
+    *pOut = sign * (int32_t)(hours * 3600 + minutes * 60);
+    return true;
+}
+
+static bool configServers(char * value)
+{
+    size_t n = 0;
+    for(char * s = strtok(value, ", \t"); s != NULL; s = strtok(NULL, ", \t")) {
+        if(n == SYNC_MAX_SERVERS || strlen(s) >= DNS_MAX_NAME)
+            return false;
+        strcpy(cfg.servers[n], s);
+        syncConfig.servers[n] = cfg.servers[n];
+        n++;
+    }
+    if(n == 0)
+        return false;
+    syncConfig.numOfServers = n;
+    return true;
+}
+
+static bool configSet(const char * key, char * value)
+{
+    long n;
+    int32_t offset;
+
+    if(!strcmp(key, "headless"))
+        return configBool(value, &cfg.headless);
+    if(!strcmp(key, "serve"))
+        return configBool(value, &cfg.serve);
+    if(!strcmp(key, "zone")) {
+        const struct TzZone * pZone = tzFind(value);
+        if(pZone == NULL)
+            return false;
+        tzSetZone(pZone);
+        cfg.hasZone = true;
+        return true;
+    }
+    if(!strcmp(key, "offset")) {
+        if(!configOffset(value, &offset))
+            return false;
+        tzSetFixed(offset);
+        cfg.hasZone = true;
+        return true;
+    }
+    if(!strcmp(key, "servers"))
+        return configServers(value);
+    if(!strcmp(key, "mode")) {
+        if(!strcmp(value, "fanout"))
+            syncConfig.mode = SYNC_FANOUT;
+        else if(!strcmp(value, "sequential"))
+            syncConfig.mode = SYNC_SEQUENTIAL;
+        else if(!strcmp(value, "broadcast"))
+            syncConfig.mode = SYNC_BROADCAST;
+        else
+            return false;
+        return true;
+    }
+    if(!strcmp(key, "best_of") && configNumber(value, 1, 16, &n)) {
+        syncConfig.bestOf = n;
+        return true;
+    }
+    if(!strcmp(key, "samples") && configNumber(value, 1, 16, &n)) {
+        syncConfig.burst = n;
+        return true;
+    }
+    if(!strcmp(key, "timeout_ms") && configNumber(value, 1, 60000, &n)) {
+        syncConfig.timeoutMs = n;
+        return true;
+    }
+    if(!strcmp(key, "retries") && configNumber(value, 1, 100, &n)) {
+        cfg.retries = n;
+        return true;
+    }
+    if(!strcmp(key, "port") && configNumber(value, 1, 65535, &n)) {
+        syncConfig.port = n;
+        return true;
+    }
+    if(!strcmp(key, "key"))
+        return authParseKey(value);
+    if(!strcmp(key, "cache_min_ttl") && configNumber(value, 0, 30*24*60*60, &n)) {
+        addrcacheSetMinTtl(n);
+        return true;
+    }
+    if(!strcmp(key, "broadcast_delay_ms") && configNumber(value, 0, 1000, &n)) {
+        syncConfig.broadcastDelayMs = n;
+        return true;
+    }
+    return false;
+}
+
+bool configLoad(void)
+{
+    FILE * f = storageOpen(CONFIG_FILE, "r");
+    if(f == NULL)
+        return false;
+
+    /* A config file means the settings are decided; don't ask. */
+    cfg.headless = true;
+
+    char line[CONFIG_LINE_BYTES];
+    for(unsigned lineNo = 1; fgets(line, sizeof(line), f) != NULL; lineNo++) {
+        line[strcspn(line, ";#\r\n")] = '\0';
+        char * s = configTrim(line);
+        if(*s == '\0' || *s == '[')
+            continue;
+
+        char * eq = strchr(s, '=');
+        if(eq == NULL) {
+            LogWarn(("%s:%u: expected key = value.", CONFIG_FILE, lineNo));
+            continue;
+        }
+        *eq = '\0';
+        char * key = configTrim(s);
+        char * value = configTrim(eq + 1);
+        for(char * k = key; *k != '\0'; k++)
+            *k = tolower((unsigned char)*k);
+        if(!configSet(key, value))
+            LogWarn(("%s:%u: ignoring %s.", CONFIG_FILE, lineNo, key));
+    }
+    fclose(f);
+    return true;
+}
+
+const struct Config * config(void)
+{
+    return &cfg;
+}
@@ -8,32 +8,44 @@
 #include <sys/socket.h>         /* Network sockets */
 #include <sys/select.h>         /* fd_set type and macros for select() */
 #include <netinet/in.h>         /* socketaddr_in */
-#include <netdb.h>              /* DNS lookups */
-#include <time.h>               /* Time and calendar */
 #include <errno.h>
 #include <core_sntp_client.h>
 #include "core_sntp_callbacks.h"
 #include "core_sntp_config_defaults.h"
+#include "dns.h"
+#include "drift.h"
+#include "ntptime.h"
+#include "phase.h"
+#include "rtclink.h"
+#include "timebase.h"
+#include "tz.h"
 
 
 /** 
  * @brief Resolves the time server domain-name to an IPv4 address. The coreSNTP 
- * client library will call this function every time the server is used. Caching
- * is not implemented, it is possible to implement.
+ * client library will call this function every time the server is used. The
+ * answer is kept by the resolver until its TTL runs out, so normally only the
+ * first call goes out to the network. That one is usually already in flight,
+ * since main() starts resolving right after connecting.
+ * 
+ * Never waits: while a lookup is in flight this fails, and the sync backs off
+ * and asks again. A name is only looked up again once its answer has expired
+ * or been dropped; one that failed waits for the next sync.
  * 
  * Corresponds to SntpResolveDns_t callback.
  */
 bool sntpResolveDns(const SntpServerInfo_t * pServerAddr,
                             uint32_t * pIpV4Addr) 
 {
-   	struct hostent * ntphost = gethostbyname(pServerAddr->pServerName);
+    dnsPoll();
+    const struct DnsQuery * query = dnsLookup(pServerAddr->pServerName);
+    if(query == NULL)
+        query = dnsResolveAsync(pServerAddr->pServerName);
 
-    if(ntphost == NULL)                 return false;
-	if(ntphost->h_addrtype != AF_INET)  return false;
-	if(ntphost->h_length < 4)           return false;
+    if(query == NULL)                   return false;
+    if(query->state != DNS_DONE)        return false;
 
-    struct in_addr addr = *(struct in_addr *)ntphost->h_addr_list[0];
-    *pIpV4Addr = htonl((uint32_t)addr.s_addr);
+    *pIpV4Addr = query->records[0].addr;
     return true;
 }
 
@@ -47,9 +59,14 @@ bool sntpResolveDns(const SntpServerInfo_t * pServerAddr,
  * Consult the corresponding documentation.
  * 2. No adjustments have been made to account for the delay in getting the
  * time from the RTC (or the function itself).
- * 3. Accuracy better than 1 second is not necessary. I would like to improve
- * this down to 10ms eventually, which is the highest date resolution of the FAT 
- * filesystem.
+ * 3. The seconds come from the RTC (through `time()`), the fractions from a
+ * hardware timer anchored to the RTC second tick (see timebase.c). Once the
+ * anchor is pinned down the timestamps are good to about a millisecond, which
+ * beats the 10ms date resolution of the FAT filesystem. Before that the
+ * fractions are zero, as they were when this only used `time()`.
+ * 4. The RTC holds local time. The timezone offset it was last written with
+ * is taken back out (see drift.c), so this is UTC and the clock offsets that
+ * coreSNTP works out are the RTC's actual error.
  * 
  * And we make the following assertions:
  * 1. There were no leap seconds between the NTP epoch (1900-01-01T00:00:00Z) 
@@ -59,64 +76,198 @@ bool sntpResolveDns(const SntpServerInfo_t * pServerAddr,
  */
 void sntpGetTime(SntpTimestamp_t * pCurrentTime)
 {
-    time_t unixTime = time(NULL);
-    if(unixTime == (time_t)(-1)) {
+    int64_t unixTimeUs = timebaseUnixUs() - (int64_t)driftRtcOffsetSec() * 1000000;
+    if(unixTimeUs < 0) {
         LogWarn(("Could not get time from RTC. Continuing."));
     }
-    pCurrentTime->seconds = unixTime + 2208988800L;
+    ntptimeFromUnixUs(unixTimeUs, pCurrentTime);
+}
+
+int64_t sntpTimestampDiffMs(const SntpTimestamp_t * a, const SntpTimestamp_t * b)
+{
+    /* The seconds wrap every era; a plain difference handles that as long
+     * as the two are less than 68 years apart. */
+    int64_t s = (int32_t)(b->seconds - a->seconds);
+    int64_t f = (int64_t)b->fractions - (int64_t)a->fractions;
+    return s * 1000 + (f * 1000) / 0x100000000LL;
+}
+
+void sntpTimestampAddMs(SntpTimestamp_t * pTime, int64_t ms)
+{
+    int64_t s = ms / 1000;
+    /* Multiplied, not shifted: ms is negative whenever our clock is ahead. */
+    int64_t f = (int64_t)pTime->fractions + (ms % 1000) * 0x100000000LL / 1000;
+    if(f < 0) {
+        f += 0x100000000LL;
+        s--;
+    }
+    else if(f >= 0x100000000LL) {
+        f -= 0x100000000LL;
+        s++;
+    }
+    pTime->seconds += (uint32_t)s;
+    pTime->fractions = (uint32_t)f;
+}
+
+/* Reads a big-endian timestamp out of a packet. */
+static void sntpReadTimestamp(const uint8_t * p, SntpTimestamp_t * pTime)
+{
+    pTime->seconds = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                     ((uint32_t)p[2] << 8) | p[3];
+    pTime->fractions = ((uint32_t)p[4] << 24) | ((uint32_t)p[5] << 16) |
+                       ((uint32_t)p[6] << 8) | p[7];
+}
+
+int64_t sntpDelayMs(const SntpTimestamp_t * pRequestTime,
+                    const SntpTimestamp_t * pResponseRxTime,
+                    const void * pPacket)
+{
+    SntpTimestamp_t rx, tx;
+    sntpReadTimestamp((const uint8_t *)pPacket + 32, &rx);     // T2
+    sntpReadTimestamp((const uint8_t *)pPacket + 40, &tx);     // T3
+    return sntpTimestampDiffMs(pRequestTime, pResponseRxTime) -
+           sntpTimestampDiffMs(&rx, &tx);
+}
+
+/* The write sntpWriteRtcAsync() started, until sntpWriteRtcPoll() sees it
+ * finish. */
+static struct {
+    bool pending;
+    int64_t second;         /* Written to the RTC */
+    int32_t rtcOffsetSec;
+} rtcWrite;
+
+bool sntpWriteRtcAsync(int64_t rtcUs, int32_t rtcOffsetSec)
+{
+    /* The RTC only takes whole seconds, so write the next one on its edge:
+     * the ARM7 holds the write until then and restarts its second tick
+     * there. SNTP_RTC_WRITE_LEAD_US leaves time for the request to get
+     * there first. */
+    int64_t us = rtcUs + SNTP_RTC_WRITE_LEAD_US + 999999;
+    int64_t s = us / 1000000 - (us % 1000000 < 0);    // Rounded down
+    uint32_t delayUs = s * 1000000 - rtcUs;
+
+    rtcTimeAndDate rtctime;
+    if(!ntptimeToRtc(s, &rtctime)) {
+        LogError(("%lli is before 2000, which the RTC can't hold.", (long long)s));
+        return false;
+    }
+    if(rtcWrite.pending || rtclinkWriteAsync(&rtctime, delayUs) == NULL) {
+        LogError(("An earlier RTC write is still pending."));
+        return false;
+    }
+    rtcWrite.pending = true;
+    rtcWrite.second = s;
+    rtcWrite.rtcOffsetSec = rtcOffsetSec;
+    return true;
+}
+
+enum RtcLinkState sntpWriteRtcPoll(void)
+{
+    rtclinkPoll();
+    const struct RtcLinkWrite * w = rtclinkLast();
+    if(!rtcWrite.pending || w->state == RTCLINK_PENDING)
+        return w->state;
+    rtcWrite.pending = false;
+
+    if(w->state != RTCLINK_DONE) {
+        /* It may still have been written, and the tick restarted. */
+        timebaseInvalidate();
+        LogError(("RTC write %lu failed (state %i, after %lu us).",
+                  (unsigned long)w->seq, w->state, (unsigned long)w->rttUs));
+        return w->state;
+    }
+    /* We know to within the ARM7's write and answer when the new second
+     * started, which beats waiting for the next edge to find out. */
+    timebaseAnchor(rtcWrite.second, w->sentUs + w->delayUs, w->answerUs);
+    driftRtcWritten(rtcWrite.second - rtcWrite.rtcOffsetSec, 0,
+                    rtcWrite.rtcOffsetSec);
+    LogInfo(("RTC set to %lli after %lu us, acknowledged in %lu us",
+             (long long)rtcWrite.second, (unsigned long)w->delayUs,
+             (unsigned long)w->rttUs));
+    return RTCLINK_DONE;
 }
 
 /**
  * @brief Obtains UTC time from an SNTP timestamp and stores it in the NDS RTC.
  * 
- * To reduce complexity, we compromised and we are using the
- * `Sntp_ConverToUnixTime` function, which is NOT Y2K28-proof. This was a
- * deliberate decition on the part of the coreSNTP team. In the near future, I
- * would like to rewrite this `sntpSetTime` function to be Y2K38-proof. This
- * probably means handling our own conversion or finding a library to do so.
+ * The conversion is our own (see ntptime.c) rather than coreSNTP's
+ * `Sntp_ConvertToUnixTime` and libc's `gmtime`, which stop at 2038 and 2099
+ * respectively. It handles the 2036 NTP era rollover, and past 2099 it keeps
+ * writing the two-digit year the RTC holds.
  * 
- * We also made the following assumptions:
- * 1. No adjustments have been made to account for the delay in getting the
- * time from the RTC (or the function itself).
- * 2. Accuracy better than 1 second is not necessary. The RTC resolution is 1
- * second and the resolution of the FAT filesystem is 2 seconds for 
- * modification time.
+ * The RTC holds local time in the zone picked with tzSetZone() or tzSetFixed(),
+ * unless RTC_IS_GMT. The offset that went into it is handed to drift.c, so
+ * sntpGetTime() can take it back out.
+ *
+ * A server whose leap indicator says its own clock isn't set (LI=3) is not
+ * believed. A leap second it announces is handed to drift.c, which accounts
+ * for the second the RTC will be off by once it has passed.
+ *
+ * Only starts the write; sntpWriteRtcPoll() says when it has landed.
  */
-void sntpSetTime(   const SntpServerInfo_t * pTimeServer, 
+bool sntpSetTime(   const SntpServerInfo_t * pTimeServer, 
                     const SntpTimestamp_t * pServerTime,
                     int64_t clockOffsetMs,
                     SntpLeapSecondInfo_t leapSecondInfo )
 {
-    uint32_t s, us;
-    SntpStatus_t status = Sntp_ConvertToUnixTime(pServerTime, &s, &us);
-    if(status != SntpSuccess) {
-        LogWarn(("Could not get time from SNTP. Skipping time setting."));
-        return;
+    if(leapSecondInfo == AlarmServerNotSynchronized) {
+        LogWarn(("%s is not synchronized; leaving the RTC alone.",
+                 pTimeServer->pServerName));
+        return false;
     }
-    struct timespec t = {
-        .tv_sec  = (us<500000)? s : s+1,
-        .tv_nsec = 0,
-    };
 
-    struct tm ts;
-    ts = RTC_IS_GMT? *gmtime(&t.tv_sec) : *localtime(&t.tv_sec);
-
-    rtcTimeAndDate rtctime = {
-        .year = ts.tm_year-100,        // -100 works until 2099. % works forever
-        .month = ts.tm_mon+1,
-        .day = ts.tm_mday,
-        .weekday = ts.tm_wday,
-        .day = ts.tm_mday,
-        .hours = ts.tm_hour,
-        .minutes = ts.tm_min,
-        .seconds = ts.tm_sec
+    int64_t unixUs = ntptimeToUnixUs(pServerTime);
+    int64_t s = unixUs / 1000000;
+    int32_t offsetSec = RTC_IS_GMT ? 0 : tzOffsetAt(s);
+    if(!sntpWriteRtcAsync(unixUs + (int64_t)offsetSec * 1000000, offsetSec))
+        return false;
+    if(leapSecondInfo == LastMinuteHas61Seconds)
+        driftLeapAnnounced(s, 1000);
+    else if(leapSecondInfo == LastMinuteHas59Seconds)
+        driftLeapAnnounced(s, -1000);
+    return true;
+}
+
+/**
+ * @brief Points the socket at the server, unless it already is. A connected
+ * UDP socket only delivers datagrams from that server, and connecting once
+ * per server instead of once per packet saves dswifi the setup each time.
+ */
+static bool sntpUdpConnect(NetworkContext_t * pNetworkContext,
+                           uint32_t serverAddr,
+                           uint16_t serverPort)
+{
+    if(pNetworkContext->connected &&
+       pNetworkContext->peerAddr == serverAddr &&
+       pNetworkContext->peerPort == serverPort)
+        return true;
+
+    struct sockaddr_in addri = {
+        .sin_family = AF_INET,
+        .sin_port = htons(serverPort),
+        .sin_addr.s_addr = htonl(serverAddr),
     };
-    fifoSendDatamsg(FIFO_USER_01, sizeof(rtctime), (void *)&rtctime);
-    LogInfo(("RTC set to %lli",t.tv_sec));
+    pNetworkContext->connected = false;
+    if(connect(pNetworkContext->udpSocket,
+               (struct sockaddr*)&addri,
+               sizeof(addri)) < 0) {
+        LogError(("Could not connect UDP socket. Errno was %i", errno));
+        return false;
+    }
+    pNetworkContext->peerAddr = serverAddr;
+    pNetworkContext->peerPort = serverPort;
+    pNetworkContext->connected = true;
+    return true;
 }
 
 /**
- * 
+ * @brief Sends a request over the session socket. Corresponds to
+ * UdpTransportSendTo_t.
+ *
+ * NOTE: dswifi select() is not implemented for UDP writes, it seems, so we
+ * don't poll for writing first.
+ * TODO: investigate further, contribute fix if necessary.
  */
 int32_t sntpUdpSend(NetworkContext_t * pNetworkContext,
                     uint32_t serverAddr,
@@ -124,47 +275,22 @@ int32_t sntpUdpSend(NetworkContext_t * pNetworkContext,
                     const void * pBuffer,
                     uint16_t bytesToSend)
 {
-    struct sockaddr_in addri;
-    addri.sin_family = AF_INET;
-    addri.sin_port = htons(serverPort);
-    addri.sin_addr.s_addr = htonl(serverAddr);
-    connect(pNetworkContext->udpSocket,
-            (struct sockaddr*)&addri,
-            sizeof(addri));
-    /*
-     * NOTE: dswifi select() is not implemented for UDP, it seems.
-     * TODO: investigate further, contribute fix if necessary.
-     * ```
-     * fd_set fds;
-     * FD_ZERO(&fds);
-     * FD_SET(pNetworkContext->udpSocket, &fds);
-     * struct timeval tout = {.tv_sec = 0, .tv_usec = 100};
-     * int r = select( pNetworkContext->udpSocket+1,
-     *                 NULL, &fds, &fds, &tout);
-     * ```
-     */
-    int r = 1;
-    if(r < 0) {
-        LogError(("Could not poll UDP socket for writing. Aborting."));
-        LogError(("Errno was %i", errno));
-        goto cleanup;
-    }
-    else if(r > 0) {
+    if(!sntpUdpConnect(pNetworkContext, serverAddr, serverPort))
+        return -1;
 
-        r = sendto( pNetworkContext->udpSocket, pBuffer, bytesToSend, 0,
-                    (const struct sockaddr *)(&addri), sizeof(addri));
+    int r = send(pNetworkContext->udpSocket, pBuffer, bytesToSend, 0);
+    if(r < 0) {
+        LogError(("Could not send SNTP request. Errno was %i", errno));
     }
-    else if(r == 0) {
-        // Timed out. This is normal.
-        goto cleanup;
+    else {
+        phaseMark(PHASE_NTP_SEND, 0);
     }
-    cleanup:
-  	shutdown(pNetworkContext->udpSocket,0);
     return r;
 }
 
 /**
- * 
+ * @brief Reads a response if one has arrived. Corresponds to
+ * UdpTransportRecvFrom_t.
  */
 int32_t sntpUdpRecv(NetworkContext_t * pNetworkContext,
                     uint32_t serverAddr,
@@ -172,36 +298,45 @@ int32_t sntpUdpRecv(NetworkContext_t * pNetworkContext,
                     void * pBuffer,
                     uint16_t bytesToRecv)
 {
-    struct sockaddr_in addri;
-    addri.sin_family = AF_INET;
-    addri.sin_port = htons(serverPort);
-    addri.sin_addr.s_addr = htonl(serverAddr);
-    connect(pNetworkContext->udpSocket,
-            (struct sockaddr*)&addri,
-            sizeof(addri));
-
-    struct timeval tout = {.tv_sec = 0, .tv_usec = 100};
+    if(!sntpUdpConnect(pNetworkContext, serverAddr, serverPort))
+        return -1;
+
+    /* Only poll; the sync task sleeps until the next interrupt between
+     * calls, and its timeout comes from the measured round trip. */
+    struct timeval tout = {.tv_sec = 0, .tv_usec = 0};
     fd_set fds;
     FD_ZERO(&fds);
     FD_SET(pNetworkContext->udpSocket, &fds);
-     
+
     int r = select( pNetworkContext->udpSocket+1,
-                    &fds, NULL, &fds, &tout);
+                    &fds, NULL, NULL, &tout);
     if(r < 0) {
-        LogWarn(("Could not open UDP socket for reading. Aborting."));
+        LogWarn(("Could not poll UDP socket for reading."));
         LogWarn(("Errno was %i", errno));
-        goto cleanup;
-    }
-    else if (r > 0) {
-        socklen_t addrlen = sizeof(addri);
-        r = recvfrom(   pNetworkContext->udpSocket, pBuffer,bytesToRecv, 0,
-                        (struct sockaddr *)(&addri), &addrlen);
+        return r;
     }
-    else if (r == 0) {
-        // Timed out. This is normal.
-        goto cleanup;
-    }
-    cleanup:
-   	shutdown(pNetworkContext->udpSocket,0);
+    if(r == 0)
+        return 0;   // Nothing yet. This is normal.
+
+    r = recv(pNetworkContext->udpSocket, pBuffer, bytesToRecv, 0);
+    if(r > 0)
+        phaseMark(PHASE_NTP_RECV, 0);
     return r;
 }
+
+void sntpUdpDrain(int udpSocket)
+{
+    uint8_t stale[SNTP_PACKET_BASE_SIZE];
+
+    /* Bounded, in case someone floods us. */
+    for(int i=0; i<8; i++) {
+        struct timeval tout = {.tv_sec = 0, .tv_usec = 0};
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(udpSocket, &fds);
+        if(select(udpSocket+1, &fds, NULL, NULL, &tout) <= 0)
+            break;
+        if(recv(udpSocket, stale, sizeof(stale), 0) < 0)
+            break;
+    }
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <nds.h>
+#include <dswifi9.h>            /* DNS servers from the DHCP lease */
+#include <sys/socket.h>         /* Network sockets */
+#include <sys/select.h>         /* fd_set type and macros for select() */
+#include <netinet/in.h>         /* socketaddr_in */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "core_sntp_config.h"
+#include "addrcache.h"
+#include "dns.h"
+#include "phase.h"
+#include "timebase.h"
+
+#define DNS_HEADER_SIZE     12
+#define DNS_PACKET_SIZE     512     /* Largest UDP answer without EDNS */
+#define DNS_TYPE_A          1
+#define DNS_CLASS_IN        1
+#define DNS_FLAG_QR         0x8000
+#define DNS_FLAG_RD         0x0100
+#define DNS_RCODE_MASK      0x000F
+
+static int dnsSocket = -1;
+static uint32_t dnsServers[2];      /* Network byte order, 0 if unused */
+static size_t dnsNumOfServers;
+static struct DnsQuery dnsQueries[DNS_MAX_QUERIES];
+static uint8_t dnsPacket[DNS_PACKET_SIZE];
+
+static uint16_t get16(const uint8_t * p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static uint32_t get32(const uint8_t * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+bool dnsInit(void)
+{
+    struct in_addr gateway, mask, dns1, dns2;
+    Wifi_GetIPInfo(&gateway, &mask, &dns1, &dns2);
+
+    dnsNumOfServers = 0;
+    if(dns1.s_addr != 0)
+        dnsServers[dnsNumOfServers++] = dns1.s_addr;
+    if(dns2.s_addr != 0 && dns2.s_addr != dns1.s_addr)
+        dnsServers[dnsNumOfServers++] = dns2.s_addr;
+    if(dnsNumOfServers == 0) {
+        LogError(("No DNS servers in the DHCP lease."));
+        return false;
+    }
+
+    if(dnsSocket < 0)
+        dnsSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if(dnsSocket < 0) {
+        LogError(("Could not open DNS socket. Errno was %i", errno));
+        return false;
+    }
+    return true;
+}
+
+void dnsClose(void)
+{
+    if(dnsSocket >= 0)
+        closesocket(dnsSocket);
+    dnsSocket = -1;
+    for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+        if(dnsQueries[i].state == DNS_PENDING)
+            dnsQueries[i].state = DNS_FAILED;
+    }
+}
+
+/* Builds the query for `pQuery` in dnsPacket. Returns its length, or 0 if the
+ * name does not fit. */
+static size_t dnsBuildQuery(const struct DnsQuery * pQuery)
+{
+    uint8_t * p = dnsPacket;
+    memset(p, 0, DNS_HEADER_SIZE);
+    p[0] = pQuery->id >> 8;
+    p[1] = pQuery->id;
+    p[2] = DNS_FLAG_RD >> 8;
+    p[5] = 1;                       // One question
+    p += DNS_HEADER_SIZE;
+
+    /* "us.pool.ntp.org" -> 2 us 4 pool 3 ntp 3 org 0 */
+    for(const char * label = pQuery->name; *label != '\0'; ) {
+        const char * dot = strchr(label, '.');
+        size_t len = dot ? (size_t)(dot - label) : strlen(label);
+        if(len == 0 || len > 63)
+            return 0;
+        *p++ = len;
+        memcpy(p, label, len);
+        p += len;
+        label += len + (dot ? 1 : 0);
+    }
+    *p++ = 0;
+    *p++ = 0; *p++ = DNS_TYPE_A;
+    *p++ = 0; *p++ = DNS_CLASS_IN;
+    return p - dnsPacket;
+}
+
+static void dnsSend(struct DnsQuery * pQuery)
+{
+    size_t len = dnsBuildQuery(pQuery);
+    if(len == 0) {
+        pQuery->state = DNS_FAILED;
+        return;
+    }
+
+    /* Ask both servers at once; whichever answers first wins. */
+    for(size_t i=0; i<dnsNumOfServers; i++) {
+        struct sockaddr_in addri = {
+            .sin_family = AF_INET,
+            .sin_port = htons(DNS_PORT),
+            .sin_addr.s_addr = dnsServers[i],
+        };
+        sendto(dnsSocket, dnsPacket, len, 0,
+               (const struct sockaddr *)&addri, sizeof(addri));
+    }
+    pQuery->sentAtUs = timebaseUs();
+    pQuery->tries++;
+    pQuery->failures = 0;
+    phaseMark(PHASE_DNS_QUERY, pQuery->tries);
+}
+
+/* Skips a (possibly compressed) name. Returns NULL if it runs past `end`. */
+static const uint8_t * dnsSkipName(const uint8_t * p, const uint8_t * end)
+{
+    while(p < end) {
+        if(*p == 0)
+            return p + 1;
+        if((*p & 0xC0) == 0xC0)
+            return p + 2 <= end ? p + 2 : NULL;
+        p += *p + 1;
+    }
+    return NULL;
+}
+
+/* Reads the A records out of an answer. */
+static void dnsParse(struct DnsQuery * pQuery, const uint8_t * packet, size_t len)
+{
+    const uint8_t * end = packet + len;
+    uint16_t flags = get16(packet + 2);
+    uint16_t qdcount = get16(packet + 4);
+    uint16_t ancount = get16(packet + 6);
+
+    if((flags & DNS_RCODE_MASK) != 0) {
+        /* Only give up once every server has said no. */
+        if(++pQuery->failures >= dnsNumOfServers)
+            pQuery->state = DNS_FAILED;
+        return;
+    }
+
+    const uint8_t * p = packet + DNS_HEADER_SIZE;
+    for(uint16_t i=0; i<qdcount && p != NULL; i++) {
+        p = dnsSkipName(p, end);
+        if(p != NULL) p += 4;
+    }
+
+    uint32_t minTtl = UINT32_MAX;
+    pQuery->numOfRecords = 0;
+    for(uint16_t i=0; i<ancount && p != NULL; i++) {
+        p = dnsSkipName(p, end);
+        if(p == NULL || p + 10 > end)
+            break;
+        uint16_t type = get16(p);
+        uint16_t class = get16(p + 2);
+        uint32_t ttl = get32(p + 4);
+        uint16_t rdlength = get16(p + 8);
+        p += 10;
+        if(p + rdlength > end)
+            break;
+        if(type == DNS_TYPE_A && class == DNS_CLASS_IN && rdlength == 4 &&
+           pQuery->numOfRecords < DNS_MAX_RECORDS) {
+            struct DnsRecord * r = &pQuery->records[pQuery->numOfRecords++];
+            r->addr = get32(p);
+            r->ttl = ttl;
+            if(ttl < minTtl) minTtl = ttl;
+        }
+        p += rdlength;
+    }
+
+    if(pQuery->numOfRecords == 0) {
+        if(++pQuery->failures >= dnsNumOfServers)
+            pQuery->state = DNS_FAILED;
+        return;
+    }
+    pQuery->expiresUs = timebaseUs() + (uint64_t)minTtl * 1000000;
+    pQuery->state = DNS_DONE;
+    phaseMark(PHASE_DNS_ANSWER, pQuery->numOfRecords);
+    addrcacheStore(pQuery->name, pQuery->records, pQuery->numOfRecords);
+    LogDebug(("%s resolved to %u addresses.", pQuery->name,
+              (unsigned)pQuery->numOfRecords));
+}
+
+static bool dnsFromServer(const struct sockaddr_in * pFrom)
+{
+    for(size_t i=0; i<dnsNumOfServers; i++) {
+        if(pFrom->sin_addr.s_addr == dnsServers[i] &&
+           pFrom->sin_port == htons(DNS_PORT))
+            return true;
+    }
+    return false;
+}
+
+void dnsPoll(void)
+{
+    if(dnsSocket < 0)
+        return;
+
+    for(;;) {
+        struct timeval tout = {.tv_sec = 0, .tv_usec = 0};
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(dnsSocket, &fds);
+        if(select(dnsSocket+1, &fds, NULL, NULL, &tout) <= 0)
+            break;
+
+        struct sockaddr_in from;
+        socklen_t fromlen = sizeof(from);
+        int r = recvfrom(dnsSocket, dnsPacket, sizeof(dnsPacket), 0,
+                         (struct sockaddr *)&from, &fromlen);
+        if(r < DNS_HEADER_SIZE)
+            break;
+        if(!dnsFromServer(&from) || !(get16(dnsPacket + 2) & DNS_FLAG_QR))
+            continue;
+
+        uint16_t id = get16(dnsPacket);
+        for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+            if(dnsQueries[i].state == DNS_PENDING && dnsQueries[i].id == id) {
+                dnsParse(&dnsQueries[i], dnsPacket, r);
+                break;
+            }
+        }
+    }
+
+    uint64_t now = timebaseUs();
+    for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+        struct DnsQuery * q = &dnsQueries[i];
+        if(q->state != DNS_PENDING ||
+           now - q->sentAtUs < (uint64_t)DNS_RETRY_SECONDS * 1000000)
+            continue;
+        if(q->tries >= DNS_TRIES) {
+            LogWarn(("DNS query for %s timed out.", q->name));
+            q->state = DNS_FAILED;
+        }
+        else
+            dnsSend(q);
+    }
+}
+
+const struct DnsQuery * dnsResolveAsync(const char * name)
+{
+    struct DnsQuery * pQuery = NULL;
+    uint64_t now = timebaseUs();
+
+    for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+        if(dnsQueries[i].state != DNS_IDLE &&
+           strncmp(dnsQueries[i].name, name, DNS_MAX_NAME) == 0) {
+            pQuery = &dnsQueries[i];
+            break;
+        }
+    }
+    if(pQuery != NULL) {
+        if(pQuery->state == DNS_PENDING ||
+           (pQuery->state == DNS_DONE && now < pQuery->expiresUs))
+            return pQuery;
+    }
+    else {
+        /* Reuse a free slot, or the one that expired first. */
+        for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+            struct DnsQuery * q = &dnsQueries[i];
+            if(q->state == DNS_PENDING)
+                continue;
+            if(pQuery == NULL || q->state == DNS_IDLE ||
+               (pQuery->state != DNS_IDLE && q->expiresUs < pQuery->expiresUs))
+                pQuery = q;
+        }
+        if(pQuery == NULL)
+            return NULL;
+    }
+
+    memset(pQuery, 0, sizeof(*pQuery));
+    strncpy(pQuery->name, name, DNS_MAX_NAME - 1);
+
+    struct in_addr literal;
+    if(inet_aton(name, &literal)) {
+        pQuery->records[0].addr = ntohl(literal.s_addr);
+        pQuery->records[0].ttl = UINT32_MAX;
+        pQuery->numOfRecords = 1;
+        pQuery->expiresUs = UINT64_MAX;
+        pQuery->state = DNS_DONE;
+        return pQuery;
+    }
+
+    pQuery->numOfRecords = addrcacheLookup(name, pQuery->records, DNS_MAX_RECORDS);
+    if(pQuery->numOfRecords != 0) {
+        pQuery->expiresUs = now + (uint64_t)pQuery->records[0].ttl * 1000000;
+        pQuery->state = DNS_DONE;
+        return pQuery;
+    }
+
+    if(dnsSocket < 0) {
+        pQuery->state = DNS_FAILED;
+        return pQuery;
+    }
+    pQuery->id = rand();
+    pQuery->state = DNS_PENDING;
+    dnsSend(pQuery);
+    return pQuery;
+}
+
+const struct DnsQuery * dnsLookup(const char * name)
+{
+    for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+        const struct DnsQuery * q = &dnsQueries[i];
+        if(q->state != DNS_IDLE && strncmp(q->name, name, DNS_MAX_NAME) == 0) {
+            if(q->state == DNS_DONE && timebaseUs() >= q->expiresUs)
+                return NULL;
+            return q;
+        }
+    }
+    return NULL;
+}
+
+const struct DnsQuery * dnsResolve(const char * name)
+{
+    const struct DnsQuery * pQuery = dnsResolveAsync(name);
+    while(pQuery != NULL && pQuery->state == DNS_PENDING) {
+        cothread_yield_irq(IRQ_VBLANK);
+        dnsPoll();
+    }
+    return pQuery;
+}
+
+void dnsDropAddress(const char * name, uint32_t addr)
+{
+    addrcacheDrop(name, addr);
+
+    for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+        struct DnsQuery * q = &dnsQueries[i];
+        if(q->state != DNS_DONE || strncmp(q->name, name, DNS_MAX_NAME) != 0)
+            continue;
+        for(size_t r=0; r<q->numOfRecords; r++) {
+            if(q->records[r].addr != addr)
+                continue;
+            memmove(&q->records[r], &q->records[r+1],
+                    (q->numOfRecords - r - 1) * sizeof(q->records[0]));
+            q->numOfRecords--;
+            break;
+        }
+        if(q->numOfRecords == 0)
+            q->state = DNS_IDLE;    // Resolve again next time
+    }
+}
+
+bool dnsPending(void)
+{
+    for(size_t i=0; i<DNS_MAX_QUERIES; i++) {
+        if(dnsQueries[i].state == DNS_PENDING)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "core_sntp_callbacks.h"
+#include "core_sntp_config.h"
+#include "drift.h"
+#include "ntptime.h"
+#include "storage.h"
+#include "timebase.h"
+
+#define DRIFT_MAGIC     0x444e544e      /* "NTND" */
+#define DRIFT_VERSION   2
+
+struct DriftFile
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    struct DriftState state;
+};
+
+/* Who is about to write the RTC, see driftRtcWritten(). */
+enum DriftWriter { DRIFT_WRITER_OTHER, DRIFT_WRITER_SYNC, DRIFT_WRITER_CORRECTION };
+
+static struct DriftState drift;
+static bool driftDirty = false;
+static bool driftCorrected = false;
+static bool driftCorrecting = false;   // Its RTC write is in flight
+static enum DriftWriter writer = DRIFT_WRITER_OTHER;
+static int64_t pendingCorrectionMs;
+
+/* Our best guess at UTC from the RTC, in seconds. */
+static int64_t driftUtcSec(void)
+{
+    return timebaseUnixUs() / 1000000 - drift.rtcOffsetSec;
+}
+
+/* RTC error from a leap second since the last sync. */
+static int64_t driftLeapMs(int64_t utcSec)
+{
+    if(drift.leapSec == 0 || drift.leapSec <= drift.syncSec ||
+       drift.leapSec > utcSec)
+        return 0;
+    return drift.leapMs;
+}
+
+void driftLoad(void)
+{
+    FILE * f = storageOpen(DRIFT_FILE, "rb");
+    if(f == NULL)
+        return;
+
+    struct DriftFile file;
+    if(fread(&file, sizeof(file), 1, f) != 1 ||
+       file.magic != DRIFT_MAGIC ||
+       file.version != DRIFT_VERSION) {
+        LogWarn(("Ignoring unreadable drift file."));
+    }
+    else {
+        drift = file.state;
+        LogDebug(("RTC drift %li ppb from %lu syncs.", (long)drift.ppb,
+                  (unsigned long)drift.numOfEstimates));
+    }
+    fclose(f);
+}
+
+bool driftSave(void)
+{
+    if(!driftDirty)
+        return true;
+
+    FILE * f = storageOpen(DRIFT_FILE, "wb");
+    if(f == NULL)
+        return false;
+
+    struct DriftFile file = {
+        .magic = DRIFT_MAGIC,
+        .version = DRIFT_VERSION,
+        .state = drift,
+    };
+    bool ok = fwrite(&file, sizeof(file), 1, f) == 1;
+    if(fclose(f) != 0)
+        ok = false;
+    if(!ok) {
+        LogWarn(("Could not save the drift estimate."));
+        return false;
+    }
+    driftDirty = false;
+    return true;
+}
+
+const struct DriftState * driftState(void)
+{
+    return &drift;
+}
+
+int32_t driftRtcOffsetSec(void)
+{
+    return drift.offsetKnown ? drift.rtcOffsetSec : 0;
+}
+
+void driftMeasured(int64_t rtcErrorMs)
+{
+    writer = DRIFT_WRITER_SYNC;
+    if(!drift.offsetKnown || drift.syncSec == 0)
+        return;
+
+    int64_t now = driftUtcSec();
+    int64_t elapsed = now - drift.syncSec;
+    if(elapsed < DRIFT_MIN_INTERVAL_S)
+        return;
+
+    /* What the RTC gained on its own since the last sync. */
+    int64_t gainedMs = rtcErrorMs - driftLeapMs(now) - drift.residualMs +
+                       drift.correctionMs;
+    int64_t ppb = gainedMs * 1000000 / elapsed;
+    if(llabs(ppb) > DRIFT_MAX_PPB) {
+        LogWarn(("RTC off by %lli ms, was it set by hand?", (long long)rtcErrorMs));
+        return;
+    }
+
+    /* Running average over the last few syncs, in case the rate changes
+     * with the seasons. */
+    uint32_t n = drift.numOfEstimates < 3 ? drift.numOfEstimates : 3;
+    drift.ppb = (int32_t)((drift.ppb * (int64_t)n + ppb) / (n + 1));
+    drift.numOfEstimates++;
+    driftDirty = true;
+    LogInfo(("RTC drift %lli ppb, estimate now %li ppb.", (long long)ppb,
+             (long)drift.ppb));
+}
+
+void driftRtcWritten(int64_t utcSec, int32_t residualMs, int32_t rtcOffsetSec)
+{
+    drift.offsetKnown = true;
+    drift.rtcOffsetSec = rtcOffsetSec;
+
+    switch(writer) {
+        case DRIFT_WRITER_SYNC:
+            drift.syncSec = utcSec;
+            drift.residualMs = residualMs;
+            drift.correctionMs = 0;
+            if(drift.leapSec <= utcSec)
+                drift.leapSec = 0;  // Passed, and the sync took it out
+            break;
+        case DRIFT_WRITER_CORRECTION:
+            /* The prediction now starts from the new, known error. */
+            drift.correctionMs += pendingCorrectionMs - residualMs;
+            break;
+        default:
+            /* We don't know how far off the clock was; start over. */
+            drift.syncSec = 0;
+            break;
+    }
+    writer = DRIFT_WRITER_OTHER;
+    driftDirty = true;
+}
+
+void driftLeapAnnounced(int64_t utcSec, int32_t leapMs)
+{
+    /* Leap seconds go at the end of a month; it takes effect at the first
+     * second of the next one. */
+    int32_t year;
+    uint32_t month, day;
+    ntptimeCivilFromDays(utcSec / 86400, &year, &month, &day);
+    if(++month > 12) {
+        month = 1;
+        year++;
+    }
+    int64_t leapSec = ntptimeDaysFromCivil(year, month, 1) * 86400;
+    if(drift.leapSec == leapSec && drift.leapMs == leapMs)
+        return;
+
+    drift.leapSec = leapSec;
+    drift.leapMs = leapMs;
+    driftDirty = true;
+    LogInfo(("Leap second (%+li ms) announced for %lli.", (long)leapMs,
+             (long long)leapSec));
+}
+
+bool driftPredictedMs(int64_t * pErrorMs)
+{
+    if(!drift.offsetKnown || drift.syncSec == 0)
+        return false;
+
+    /* Without a drift estimate, a passed leap second is still a known
+     * error. */
+    int64_t now = driftUtcSec();
+    int64_t elapsed = now - drift.syncSec;
+    int64_t leapMs = driftLeapMs(now);
+    if(drift.numOfEstimates == 0 && leapMs == 0)
+        return false;
+    *pErrorMs = drift.residualMs - drift.correctionMs + leapMs +
+                (int64_t)drift.ppb * elapsed / 1000000;
+    return true;
+}
+
+bool driftCorrect(void)
+{
+    if(driftCorrecting) {
+        /* Whoever polls first after the answer does the bookkeeping; a sync
+         * may have beaten us to it. */
+        enum RtcLinkState state = sntpWriteRtcPoll();
+        if(state == RTCLINK_PENDING)
+            return false;
+        driftCorrecting = false;
+        if(state != RTCLINK_DONE && writer == DRIFT_WRITER_CORRECTION)
+            writer = DRIFT_WRITER_OTHER;
+        return true;
+    }
+    if(driftCorrected)
+        return true;
+    if(timebaseWindowUs() > TIMEBASE_GOOD_WINDOW_US)
+        return false;
+    driftCorrected = true;
+
+    int64_t errorMs;
+    if(!driftPredictedMs(&errorMs) || llabs(errorMs) < DRIFT_CORRECT_MIN_MS)
+        return true;
+
+    LogInfo(("Taking %lli ms of predicted drift out of the RTC.",
+             (long long)errorMs));
+    writer = DRIFT_WRITER_CORRECTION;
+    pendingCorrectionMs = errorMs;
+    int64_t rtcUs = timebaseUnixUs() - errorMs * 1000;
+    if(sntpWriteRtcAsync(rtcUs, drift.rtcOffsetSec)) {
+        driftCorrecting = true;
+        return false;
+    }
+    writer = DRIFT_WRITER_OTHER;
+    return true;
+}
+
+int64_t driftNextSyncSec(void)
+{
+    if(drift.syncSec == 0)
+        return driftUtcSec();
+    if(drift.numOfEstimates == 0)
+        return drift.syncSec + DRIFT_DEFAULT_INTERVAL_S;
+
+    int64_t ppb = llabs(drift.ppb) / 10;
+    if(ppb < DRIFT_UNCERTAINTY_PPB)
+        ppb = DRIFT_UNCERTAINTY_PPB;
+    int64_t interval = (int64_t)DRIFT_TOLERANCE_MS * 1000000 / ppb;
+    if(interval > DRIFT_MAX_INTERVAL_S)
+        interval = DRIFT_MAX_INTERVAL_S;
+    return drift.syncSec + interval;
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <sys/socket.h>         /* Network sockets */
+#include <sys/select.h>         /* fd_set type and macros for select() */
+#include <netinet/in.h>         /* socketaddr_in */
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <core_sntp_client.h>
+#include "core_sntp_callbacks.h"
+#include "core_sntp_config.h"
+#include "dns.h"
+#include "fanout.h"
+#include "phase.h"
+
+static bool fanoutHasAddr(const struct Fanout * pFanout, uint32_t addr, uint16_t port)
+{
+    for(size_t i=0; i<pFanout->numOfServers; i++) {
+        if(pFanout->servers[i].addr == addr &&
+           pFanout->servers[i].pInfo->port == port)
+            return true;
+    }
+    return false;
+}
+
+void fanoutInit(struct Fanout * pFanout)
+{
+    memset(pFanout, 0, sizeof(*pFanout));
+    pFanout->udpSocket = -1;
+    pFanout->best = FANOUT_NONE;
+}
+
+void fanoutClear(struct Fanout * pFanout)
+{
+    int udpSocket = pFanout->udpSocket;
+    fanoutInit(pFanout);
+    pFanout->udpSocket = udpSocket;
+}
+
+size_t fanoutAddServers(struct Fanout * pFanout,
+                        const SntpServerInfo_t * pServers,
+                        size_t numOfServers)
+{
+    for(size_t s=0; s<numOfServers; s++) {
+        const struct DnsQuery * query = dnsLookup(pServers[s].pServerName);
+        if(query == NULL || query->state != DNS_DONE) {
+            LogWarn(("Could not resolve %s.", pServers[s].pServerName));
+            continue;
+        }
+
+        for(size_t i=0; i<query->numOfRecords; i++) {
+            if(pFanout->numOfServers >= FANOUT_MAX_SERVERS)
+                return pFanout->numOfServers;
+
+            uint32_t addr = query->records[i].addr;
+            if(fanoutHasAddr(pFanout, addr, pServers[s].port))
+                continue;
+
+            struct FanoutServer * pServer = &pFanout->servers[pFanout->numOfServers++];
+            pServer->pInfo = &pServers[s];
+            pServer->addr = addr;
+            pServer->status = SntpNoResponseReceived;
+            pServer->latencyMs = -1;
+            pServer->delayMs = -1;
+        }
+    }
+    return pFanout->numOfServers;
+}
+
+SntpStatus_t fanoutStart(struct Fanout * pFanout,
+                         size_t bestOf,
+                         uint32_t timeoutMs)
+{
+    if(pFanout->numOfServers == 0)
+        return SntpErrorDnsFailure;
+
+    if(pFanout->udpSocket < 0)
+        pFanout->udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if(pFanout->udpSocket < 0) {
+        LogError(("Could not open UDP socket. Errno was %i", errno));
+        return SntpErrorNetworkFailure;
+    }
+    sntpUdpDrain(pFanout->udpSocket);
+
+    pFanout->numOfResponses = 0;
+    pFanout->numOfAnswered = 0;
+    pFanout->best = FANOUT_NONE;
+    pFanout->bestOf = bestOf ? bestOf : 1;
+    pFanout->timedOut = false;
+    pFanout->rateLimited = false;
+    pFanout->timeoutMs = timeoutMs;
+    sntpGetTime(&pFanout->start);
+
+    size_t sent = 0, excluded = 0;
+    for(size_t i=0; i<pFanout->numOfServers; i++) {
+        struct FanoutServer * pServer = &pFanout->servers[i];
+        if(pServer->excluded) {
+            excluded++;
+            continue;
+        }
+
+        struct sockaddr_in addri = {
+            .sin_family = AF_INET,
+            .sin_port = htons(pServer->pInfo->port),
+            .sin_addr.s_addr = htonl(pServer->addr),
+        };
+
+        pServer->status = SntpNoResponseReceived;
+        pServer->latencyMs = -1;
+        pServer->delayMs = -1;
+        sntpGetTime(&pServer->requestTime);
+        Sntp_SerializeRequest(&pServer->requestTime, rand(),
+                              pFanout->buffer, sizeof(pFanout->buffer));
+        int length = SNTP_PACKET_BASE_SIZE + authSign(pFanout->buffer);
+        int r = sendto(pFanout->udpSocket, pFanout->buffer, length, 0,
+                       (const struct sockaddr *)&addri, sizeof(addri));
+        if(r == length) {
+            phaseMark(PHASE_NTP_SEND, i);
+            sent++;
+        }
+        else
+            pServer->status = SntpErrorNetworkFailure;
+    }
+
+    if(sent == 0) {
+        return excluded == pFanout->numOfServers ? SntpRejectedResponse
+                                                 : SntpErrorNetworkFailure;
+    }
+    /* Servers we skipped or could not send to count as answered, so we don't
+     * wait for them. */
+    pFanout->numOfAnswered = pFanout->numOfServers - sent;
+    return SntpSuccess;
+}
+
+/* Matches a datagram to the request it answers and records the result. */
+static void fanoutReceive(struct Fanout * pFanout,
+                          const struct sockaddr_in * pFrom,
+                          size_t length)
+{
+    SntpTimestamp_t rxTime;
+    sntpGetTime(&rxTime);
+
+    for(size_t i=0; i<pFanout->numOfServers; i++) {
+        struct FanoutServer * pServer = &pFanout->servers[i];
+        if(pServer->addr != ntohl(pFrom->sin_addr.s_addr) ||
+           pServer->pInfo->port != ntohs(pFrom->sin_port) ||
+           pServer->status != SntpNoResponseReceived)
+            continue;
+
+        if(!authCheck(pFanout->buffer, length)) {
+            /* Forged, a crypto-NAK, or the server doesn't have our key.
+             * Keep waiting, in case the real response is still coming. */
+            LogWarn(("Response from %s failed authentication.",
+                     pServer->pInfo->pServerName));
+            return;
+        }
+
+        SntpStatus_t status = Sntp_DeserializeResponse(&pServer->requestTime,
+                                                       &rxTime,
+                                                       pFanout->buffer,
+                                                       length,
+                                                       &pServer->response);
+        if(status == SntpInvalidResponse || status == SntpErrorBufferTooSmall)
+            return;     // Stray or spoofed packet; keep waiting for the real one
+
+        pServer->status = status;
+        pFanout->numOfAnswered++;
+        if(status != SntpSuccess) {
+            LogWarn(("Server %s rejected the request (%i).",
+                     pServer->pInfo->pServerName, status));
+            /* RATE, DENY or RSTR: leave this address alone from now on. */
+            pServer->excluded = true;
+            if(status == SntpRejectedResponseRetryWithBackoff)
+                pFanout->rateLimited = true;
+            return;
+        }
+
+        if(pServer->response.leapSecondType == AlarmServerNotSynchronized) {
+            /* LI=3: its own clock isn't set. It may be later, so it is not
+             * excluded. */
+            LogWarn(("Server %s is not synchronized.",
+                     pServer->pInfo->pServerName));
+            pServer->status = SntpRejectedResponse;
+            return;
+        }
+
+        phaseMark(PHASE_NTP_RECV, i);
+        pServer->latencyMs = sntpTimestampDiffMs(&pServer->requestTime, &rxTime);
+        pServer->delayMs = sntpDelayMs(&pServer->requestTime, &rxTime,
+                                       pFanout->buffer);
+        if(pFanout->best == FANOUT_NONE ||
+           pServer->delayMs < pFanout->servers[pFanout->best].delayMs)
+            pFanout->best = i;
+        pFanout->numOfResponses++;
+        return;
+    }
+}
+
+SntpStatus_t fanoutPoll(struct Fanout * pFanout, uint32_t waitMs)
+{
+    struct timeval tout = {
+        .tv_sec = waitMs / 1000,
+        .tv_usec = (waitMs % 1000) * 1000
+    };
+
+    while(pFanout->numOfResponses < pFanout->bestOf &&
+          pFanout->numOfAnswered < pFanout->numOfServers) {
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(pFanout->udpSocket, &fds);
+        int r = select(pFanout->udpSocket+1, &fds, NULL, NULL, &tout);
+        if(r <= 0)
+            break;
+        tout.tv_sec = tout.tv_usec = 0;     // Only wait for the first one
+
+        struct sockaddr_in from;
+        socklen_t fromlen = sizeof(from);
+        r = recvfrom(pFanout->udpSocket, pFanout->buffer, sizeof(pFanout->buffer), 0,
+                     (struct sockaddr *)&from, &fromlen);
+        if(r < 0)
+            break;
+        fanoutReceive(pFanout, &from, r);
+    }
+
+    if(pFanout->numOfResponses >= pFanout->bestOf ||
+       pFanout->numOfAnswered >= pFanout->numOfServers) {
+        return pFanout->best != FANOUT_NONE ? SntpSuccess : SntpErrorResponseTimeout;
+    }
+
+    SntpTimestamp_t now;
+    sntpGetTime(&now);
+    if(sntpTimestampDiffMs(&pFanout->start, &now) >= pFanout->timeoutMs) {
+        pFanout->timedOut = true;
+        return pFanout->best != FANOUT_NONE ? SntpSuccess : SntpErrorResponseTimeout;
+    }
+    return SntpNoResponseReceived;
+}
+
+size_t fanoutUsable(const struct Fanout * pFanout)
+{
+    size_t n = 0;
+    for(size_t i=0; i<pFanout->numOfServers; i++) {
+        if(!pFanout->servers[i].excluded)
+            n++;
+    }
+    return n;
+}
+
+void fanoutClose(struct Fanout * pFanout)
+{
+    if(pFanout->udpSocket >= 0)
+        closesocket(pFanout->udpSocket);
+    pFanout->udpSocket = -1;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <nds.h>
+#include "idle.h"
+#include "timebase.h"
+
+/* Any of the keys the ARM9 can see. */
+#define IDLE_KEYS       (KEY_A | KEY_B | KEY_SELECT | KEY_START | KEY_RIGHT | \
+                         KEY_LEFT | KEY_UP | KEY_DOWN | KEY_R | KEY_L)
+#define IDLE_KEYCNT_IRQ (1 << 14)
+#define IDLE_FRAME_US   16715
+
+static struct IdleStats stats;
+
+/* The timer reloads, so stop it on the first overflow. */
+static void idleTimerIrq(void)
+{
+    timerStop(IDLE_TIMER);
+}
+
+void idleInit(void)
+{
+    REG_KEYCNT = IDLE_KEYCNT_IRQ | IDLE_KEYS;
+    irqEnable(IRQ_KEYS);
+    idleResetStats();
+}
+
+void idleWait(uint32_t irqMask, uint32_t timeoutUs)
+{
+    if(keysHeld() != 0 || timebaseWindowUs() > TIMEBASE_GOOD_WINDOW_US)
+        irqMask |= IRQ_VBLANK;
+    else
+        irqMask |= IRQ_KEYS;
+
+    /* No point in the timer if a VBlank comes first anyway. */
+    bool timed = timeoutUs > 0 &&
+                 !((irqMask & IRQ_VBLANK) && timeoutUs >= IDLE_FRAME_US);
+    if(timed) {
+        if(timeoutUs > IDLE_MAX_TIMER_US)
+            timeoutUs = IDLE_MAX_TIMER_US;
+        uint32_t ticks = (uint64_t)timeoutUs * (BUS_CLOCK / 1024) / 1000000;
+        if(ticks == 0)
+            ticks = 1;
+        timerStart(IDLE_TIMER, ClockDivider_1024, (u16)(0x10000 - ticks),
+                   idleTimerIrq);
+        irqMask |= IRQ_TIMER(IDLE_TIMER);
+    }
+
+    uint64_t start = timebaseUs();
+    cothread_yield_irq(irqMask);
+    stats.sleptUs += timebaseUs() - start;
+    stats.wakeups++;
+    if(timed)
+        timerStop(IDLE_TIMER);
+}
+
+uint32_t idleUsToNextSecond(void)
+{
+    int64_t us = timebaseUnixUs();
+    return 1000000 - (uint32_t)(us % 1000000);
+}
+
+const struct IdleStats * idleStats(void)
+{
+    return &stats;
+}
+
+void idleResetStats(void)
+{
+    stats.wakeups = 0;
+    stats.sleptUs = 0;
+    stats.sinceUs = timebaseUs();
+}
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <ctype.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include "log.h"
+#include "storage.h"
+#include "timebase.h"
+
+#define LOG_LINE_BYTES  160
+
+/* One conversion of a printf format, e.g. "%-5.*lli". */
+struct LogSpec
+{
+    size_t length;          /* From the '%' to the conversion, inclusive */
+    size_t sizeAt;          /* Where the length modifier starts */
+    char size;              /* 0, 'h', 'H' (hh), 'l', 'L' (ll), 'z', 'j',
+                             * 't' or 'D' (long double) */
+    char conversion;        /* 0 if the format ends first */
+    uint8_t stars;          /* `*` widths and precisions */
+};
+
+static struct LogEntry logEntries[LOG_MAX_ENTRIES];
+static uint32_t logTotal;           /* Entries ever written */
+static uint32_t logPrinted;         /* ...printed by logFlush() */
+static uint32_t logSaved;           /* ...and saved to LOG_FILE */
+static bool logBootSaved = false;
+
+static void logParseSpec(const char * p, struct LogSpec * pSpec)
+{
+    const char * s = p + 1;
+
+    pSpec->stars = 0;
+    pSpec->size = 0;
+    while(*s != '\0' && strchr("-+ #0", *s) != NULL)
+        s++;
+    if(*s == '*') {
+        pSpec->stars++;
+        s++;
+    }
+    while(isdigit((unsigned char)*s))
+        s++;
+    if(*s == '.') {
+        s++;
+        if(*s == '*') {
+            pSpec->stars++;
+            s++;
+        }
+        while(isdigit((unsigned char)*s))
+            s++;
+    }
+
+    pSpec->sizeAt = s - p;
+    switch(*s) {
+        case 'h':
+        case 'l':
+            pSpec->size = *s++;
+            if(*s == pSpec->size) {
+                pSpec->size = pSpec->size == 'h' ? 'H' : 'L';
+                s++;
+            }
+            break;
+        case 'z':
+        case 'j':
+        case 't':
+            pSpec->size = *s++;
+            break;
+        case 'L':
+            pSpec->size = 'D';
+            s++;
+            break;
+    }
+
+    pSpec->conversion = *s;
+    pSpec->length = (*s != '\0' ? s + 1 : s) - p;
+}
+
+static long long logSignedArg(va_list * pAp, char size)
+{
+    switch(size) {
+        case 'H': return (signed char)va_arg(*pAp, int);
+        case 'h': return (short)va_arg(*pAp, int);
+        case 'l': return va_arg(*pAp, long);
+        case 'L': return va_arg(*pAp, long long);
+        case 'z': return va_arg(*pAp, ptrdiff_t);   // Signed size_t
+        case 'j': return va_arg(*pAp, intmax_t);
+        case 't': return va_arg(*pAp, ptrdiff_t);
+        default:  return va_arg(*pAp, int);
+    }
+}
+
+static long long logUnsignedArg(va_list * pAp, char size)
+{
+    switch(size) {
+        case 'H': return (unsigned char)va_arg(*pAp, unsigned int);
+        case 'h': return (unsigned short)va_arg(*pAp, unsigned int);
+        case 'l': return va_arg(*pAp, unsigned long);
+        case 'L': return va_arg(*pAp, unsigned long long);
+        case 'z': return va_arg(*pAp, size_t);
+        case 'j': return va_arg(*pAp, uintmax_t);
+        case 't': return va_arg(*pAp, ptrdiff_t);
+        default:  return va_arg(*pAp, unsigned int);
+    }
+}
+
+void logWrite(uint8_t level, const char * format, ...)
+{
+    struct LogEntry * e = &logEntries[logTotal % LOG_MAX_ENTRIES];
+    size_t textUsed = 0;
+    va_list ap;
+
+    e->us = timebaseUs();
+    e->format = format;
+    e->level = level;
+    e->numOfArgs = 0;
+
+    va_start(ap, format);
+    for(const char * p = strchr(format, '%'); p != NULL; p = strchr(p, '%')) {
+        struct LogSpec spec;
+        logParseSpec(p, &spec);
+        p += spec.length;
+        if(spec.conversion == '%')
+            continue;
+        if(spec.conversion == '\0' ||
+           e->numOfArgs + spec.stars + 1 > LOG_MAX_ARGS)
+            break;
+
+        for(uint8_t i=0; i<spec.stars; i++)
+            e->args[e->numOfArgs++].i = va_arg(ap, int);
+
+        union LogArg * a = &e->args[e->numOfArgs++];
+        switch(spec.conversion) {
+            case 'd':
+            case 'i':
+                a->i = logSignedArg(&ap, spec.size);
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                a->i = logUnsignedArg(&ap, spec.size);
+                break;
+            case 'c':
+                a->i = va_arg(ap, int);
+                break;
+            case 's': {
+                const char * s = va_arg(ap, const char *);
+                if(s == NULL)
+                    s = "(null)";
+                size_t room = LOG_TEXT_BYTES - textUsed;
+                size_t n = strlen(s);
+                if(n >= room)
+                    n = room - 1;
+                a->i = textUsed;
+                memcpy(e->text + textUsed, s, n);
+                e->text[textUsed + n] = '\0';
+                textUsed += n + (textUsed + n + 1 < LOG_TEXT_BYTES);
+                break;
+            }
+            case 'p':
+            case 'n':
+                a->p = va_arg(ap, const void *);
+                break;
+            case 'e': case 'E':
+            case 'f': case 'F':
+            case 'g': case 'G':
+            case 'a': case 'A':
+                a->d = spec.size == 'D' ? (double)va_arg(ap, long double)
+                                        : va_arg(ap, double);
+                break;
+            default:
+                /* Don't know what it takes, so nothing after it can be read
+                 * either. */
+                e->numOfArgs--;
+                goto done;
+        }
+    }
+done:
+    va_end(ap);
+    logTotal++;
+}
+
+size_t logCount(void)
+{
+    return logTotal < LOG_MAX_ENTRIES ? logTotal : LOG_MAX_ENTRIES;
+}
+
+const struct LogEntry * logGet(size_t i)
+{
+    uint32_t first = logTotal - logCount();
+    return &logEntries[(first + i) % LOG_MAX_ENTRIES];
+}
+
+/* Where the next piece goes. Past the end of the buffer, snprintf() still
+ * counts what would have been written. */
+#define LOG_OUT     (used < size ? pBuffer + used : NULL), \
+                    (used < size ? size - used : 0)
+
+/* Prints one argument with its `*` widths. */
+#define LOG_EMIT(value)                                                     \
+    r = spec.stars == 0 ? snprintf(LOG_OUT, fmt, value) :                   \
+        spec.stars == 1 ? snprintf(LOG_OUT, fmt, (int)e->args[n].i, value) :\
+        snprintf(LOG_OUT, fmt, (int)e->args[n].i, (int)e->args[n+1].i, value)
+
+int logFormat(const struct LogEntry * pEntry, char * pBuffer, size_t size)
+{
+    static const char * const levelNames[] = {
+        [LOG_LEVEL_ERROR] = "ERR",
+        [LOG_LEVEL_WARN] = "WRN",
+        [LOG_LEVEL_INFO] = "inf",
+        [LOG_LEVEL_DEBUG] = "dbg",
+    };
+    const struct LogEntry * e = pEntry;
+    const char * name = e->level <= LOG_LEVEL_DEBUG && levelNames[e->level]
+                        ? levelNames[e->level] : "???";
+    size_t used = 0;
+    int r = snprintf(LOG_OUT, "NTP-%s: ", name);
+    used += r > 0 ? r : 0;
+
+    const char * p = e->format;
+    size_t n = 0;
+    while(*p != '\0') {
+        const char * next = strchr(p, '%');
+        size_t literal = next != NULL ? (size_t)(next - p) : strlen(p);
+        r = snprintf(LOG_OUT, "%.*s", (int)literal, p);
+        used += r > 0 ? r : 0;
+        p += literal;
+        if(next == NULL)
+            break;
+
+        struct LogSpec spec;
+        logParseSpec(p, &spec);
+        if(spec.conversion == '%') {
+            r = snprintf(LOG_OUT, "%%");
+        }
+        else if(spec.conversion == '\0' || n + spec.stars + 1 > e->numOfArgs) {
+            /* Ran out of arguments: show the rest as it is. */
+            r = snprintf(LOG_OUT, "%s", p);
+            used += r > 0 ? r : 0;
+            break;
+        }
+        else {
+            /* The spec less its length modifier, with one that matches the
+             * type the argument is stored as. */
+            char fmt[24];
+            size_t keep = spec.sizeAt < sizeof(fmt) - 4 ? spec.sizeAt
+                                                        : sizeof(fmt) - 4;
+            memcpy(fmt, p, keep);
+            const union LogArg * a = &e->args[n + spec.stars];
+            switch(spec.conversion) {
+                case 'd': case 'i':
+                case 'u': case 'o': case 'x': case 'X':
+                    snprintf(fmt + keep, sizeof(fmt) - keep, "ll%c",
+                             spec.conversion);
+                    if(spec.conversion == 'd' || spec.conversion == 'i')
+                        LOG_EMIT(a->i);
+                    else
+                        LOG_EMIT((unsigned long long)a->i);
+                    break;
+                case 'c':
+                    snprintf(fmt + keep, sizeof(fmt) - keep, "c");
+                    LOG_EMIT((int)a->i);
+                    break;
+                case 's':
+                    snprintf(fmt + keep, sizeof(fmt) - keep, "s");
+                    LOG_EMIT(e->text + a->i);
+                    break;
+                case 'p':
+                    snprintf(fmt + keep, sizeof(fmt) - keep, "p");
+                    LOG_EMIT(a->p);
+                    break;
+                case 'n':
+                    r = 0;
+                    break;
+                default:
+                    snprintf(fmt + keep, sizeof(fmt) - keep, "%c",
+                             spec.conversion);
+                    LOG_EMIT(a->d);
+                    break;
+            }
+            n += spec.stars + 1;
+        }
+        used += r > 0 ? r : 0;
+        p += spec.length;
+    }
+
+    /* Some messages end in a newline of their own. */
+    while(used > 0 && used < size && pBuffer[used - 1] == '\n')
+        pBuffer[--used] = '\0';
+    return used;
+}
+
+void logFlush(FILE * f)
+{
+    char line[LOG_LINE_BYTES];
+    uint32_t first = logTotal - logCount();
+
+    if(logPrinted < first)
+        logPrinted = first;
+    for(; logPrinted < logTotal; logPrinted++) {
+        logFormat(&logEntries[logPrinted % LOG_MAX_ENTRIES], line, sizeof(line));
+        fprintf(f, "%s\n", line);
+    }
+}
+
+void logPrintTail(size_t n)
+{
+    char line[LOG_LINE_BYTES];
+    size_t count = logCount();
+
+    for(size_t i = count > n ? count - n : 0; i < count; i++) {
+        logFormat(logGet(i), line, sizeof(line));
+        printf("%s\n", line);
+    }
+}
+
+bool logSave(void)
+{
+    char line[LOG_LINE_BYTES];
+    uint32_t first = logTotal - logCount();
+
+    if(logSaved == logTotal)
+        return true;
+    if(!storageAvailable()) {
+        logSaved = logTotal;
+        return false;
+    }
+
+    FILE * f = storageOpen(LOG_FILE, "a");
+    if(f == NULL) {
+        logSaved = logTotal;
+        return false;
+    }
+    if(!logBootSaved) {
+        fprintf(f, "--- new session, RTC %lli\n", (long long)time(NULL));
+        logBootSaved = true;
+    }
+    if(logSaved < first)
+        logSaved = first;
+    for(; logSaved < logTotal; logSaved++) {
+        const struct LogEntry * e = &logEntries[logSaved % LOG_MAX_ENTRIES];
+        logFormat(e, line, sizeof(line));
+        fprintf(f, "%5llu.%06llu %s\n", (unsigned long long)(e->us / 1000000),
+                (unsigned long long)(e->us % 1000000), line);
+    }
+    return fclose(f) == 0;
+}
@@ -13,37 +13,38 @@
 #include <dswifi9.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
-#include <netdb.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <assert.h>
 #include <time.h>
 #include <core_sntp_client.h>
 #include "core_sntp_callbacks.h"
 #include "core_sntp_config.h"
-
-/* Configuration constants for the SNTP client. */
-#define NTP_TIMEOUT						3000
-#define NTP_SEND_WAIT_TIME_MS 			2000
-#define NTP_RECEIVE_WAIT_TIME_MS		1000
+#include "addrcache.h"
+#include "config.h"
+#include "dns.h"
+#include "drift.h"
+#include "idle.h"
+#include "log.h"
+#include "phase.h"
+#include "rtclink.h"
+#include "screen.h"
+#include "server.h"
+#include "storage.h"
+#include "sync.h"
+#include "timebase.h"
+#include "tz.h"
 
 /* Function macros */
 #define IF_DIAGNOSTICS					\
 	if(keysHeld() & (KEY_L|KEY_R))
 
-/* Environment variables *
- * These are used by some POSIX functions and are normally provided by the
- * operating system. They are not provided by the NDS homebrew launchers though.
- * So we provide the TZ variable ourselves for `localtime()` to do all timezone
- * conversions.
- */
-static char ndsntp_env_tz[256] = "";
-static char *ndsntp_env[] = {
-	ndsntp_env_tz,
-	NULL
-};
-extern char **environ;
-char **environ = &ndsntp_env[0];	// Provide our own environment variables
+/* Drift correction needs a good clock anchor; poll this long across a second
+ * edge for one. A bit more than a frame. */
+#define DRIFT_REFINE_SPIN_US	20000
+/* How long to keep at it before exiting without WiFi. */
+#define DRIFT_EXIT_WAIT_US		5000000
 
 /* Global types */
 struct Tz {
@@ -53,28 +54,58 @@ struct Tz {
 
 enum Menu { MENU_TZ, MENU_SYNCING, MENU_SYNCED, MENU_EXIT };
 
+enum Radio { RADIO_OFF, RADIO_CONNECTING, RADIO_ON };
+
+/* Global variables */
+static bool headless = false;	// ndsntp.ini said to sync and exit
+static enum Radio radio = RADIO_OFF;	// Off between syncs, to save battery
+static bool serve = false;		// Serve time to other consoles after a sync
+
 /* Function prototypes */
 void spinloop(void);
 unsigned int sleeprtc(unsigned int seconds);
+void idleMenu(void);
+bool correctDrift(void);
+void correctDriftBeforeExit(void);
+void wifiPowerDown(void);
+int wifiPowerUp(void);
+bool serveStart(void);
 void printIpInfo(void);
 int printNsLookup(void);
-void printEnviron(void);
-int syncTime(int retries);
+void printFanout(void);
 enum Menu displayTZMenu(void);
+enum Menu displaySyncingMenu(void);
 enum Menu displaySyncedMenu(void);
 
-/* Global vairiables */
-const char * ntpurl = "us.pool.ntp.org";
-
 int main(void) {
 
-	consoleDemoInit();
+	screenInit(consoleDemoInit());
+	timebaseInit();
+	idleInit();
+	phaseInit();
+
+	/* Addresses resolved by a previous run let the first request go out
+	 * without waiting for DNS. With the timezone from last time as well, the
+	 * sync starts the moment there is an IP address and the first screen is
+	 * the synced one. */
+	bool fastStart = false;
+	if(storageInit()) {
+		driftLoad();	// addrcacheLoad() needs the RTC's offset from UTC
+		addrcacheLoad();
+		fastStart = tzLoad();
+		if(configLoad()) {
+			fastStart = fastStart || config()->hasZone || config()->headless;
+			headless = config()->headless;
+			serve = config()->serve;
+		}
+	}
 
 	printf("Connecting to WLAN\n");
 	
 	if(!Wifi_InitDefault(INIT_ONLY | WIFI_ATTEMPT_DSI_MODE)) {
 		printf("WIFI hardware initialization failed.\n");
-		spinloop();
+		correctDriftBeforeExit();
+		if(!headless) spinloop();
 		goto end;
 	}
 	
@@ -89,20 +120,28 @@ int main(void) {
 				// the new WiFi lib passes through this state before searching
 				break;
 			case ASSOCSTATUS_SEARCHING:
-				if(sl != s)
+				if(sl != s) {
+					phaseMark(PHASE_WIFI_SEARCHING, 0);
 					printf("Searching for AP...\n");
+				}
 				break;
 			case ASSOCSTATUS_ASSOCIATING:
-				if(sl != s)
+				if(sl != s) {
+					phaseMark(PHASE_WIFI_ASSOCIATING, 0);
 					printf("Associating...\n");
+				}
 				break;
 			case ASSOCSTATUS_AUTHENTICATING:
-				if(sl != s)
+				if(sl != s) {
+					phaseMark(PHASE_WIFI_AUTHENTICATING, 0);
 					printf("Authenticating...\n");
+				}
 				break;
 			case ASSOCSTATUS_ACQUIRINGDHCP:
-				if(sl != s) 
+				if(sl != s) {
+					phaseMark(PHASE_WIFI_DHCP, 0);
 					printf("Acquiring IP address...\n");
+				}
 				break;
 			case ASSOCSTATUS_ASSOCIATED:
 				printf("Associated!\n");
@@ -112,12 +151,24 @@ int main(void) {
 				[[fallthrough]];
 			default:
 				printf("WFC connection failed. Check your wireless settings.\n");
-				spinloop();
+				correctDriftBeforeExit();
+				if(!headless) spinloop();
 				goto end;
 		}
-		cothread_yield_irq(IRQ_VBLANK);
+		/* The FIFO brings the ARM7's answer to the correction's RTC write. */
+		cothread_yield_irq(IRQ_VBLANK | IRQ_FIFO_NOT_EMPTY);
+		timebaseUpdate();
+		correctDrift();
 	}
+	phaseMark(PHASE_WIFI_ASSOCIATED, 0);
 	printf("Connected to the AP!\n");
+	radio = RADIO_ON;
+
+	/* Get the lookups going now, they finish while the user picks a timezone. */
+	if(dnsInit()) {
+		for(size_t i=0; i<syncConfig.numOfServers; i++)
+			dnsResolveAsync(syncConfig.servers[i]);
+	}
 
 	scanKeys();
 	IF_DIAGNOSTICS {
@@ -132,24 +183,28 @@ int main(void) {
 	}
 
 	enum Menu menu = MENU_TZ;
+	if(fastStart) {
+		syncStart(config()->retries);
+		menu = MENU_SYNCING;
+	}
 	while( 1 )
     {
+		dnsPoll();
+		serverPoll();
+		timebaseUpdate();
+		/* Keep the card and the RTC out of the way while a sync is in
+		 * flight. */
+		if(menu != MENU_SYNCING) {
+			logSave();
+			correctDrift();
+		}
+		enum Menu last = menu;
 		switch(menu) {
 			case MENU_TZ:
 				menu = displayTZMenu();
 				break;
 			case MENU_SYNCING:
-				cothread_yield_irq(IRQ_VBLANK);
-				scanKeys();
-				printf("\x1b[2J"); // Clear console
-				printf("\n\n");
-				if(syncTime(5)) {
-					printf("Couldn't connect to time server(s)!\n");
-				}
-				IF_DIAGNOSTICS {
-					sleeprtc(2);
-				}
-				menu = MENU_SYNCED;
+				menu = displaySyncingMenu();
 				break;
 			case MENU_SYNCED:
 				menu = displaySyncedMenu();
@@ -159,39 +214,138 @@ int main(void) {
 			default:
 				menu = MENU_TZ;
 		}
-
-
-
-		printf("\n\n");
+		/* A new menu, or whatever was printed on the way to it, needs the
+		 * whole screen redrawn. */
+		if(menu != last)
+			screenInvalidate();
     }
 	end:
+	correctDriftBeforeExit();
+	serverStop();
+	syncShutdown();
+	dnsClose();
+	logSave();
 	return 0;
 }
 
-/* Do nothing until a key is pressed.
+/* Do nothing until a key is pressed. The ARM9 stays halted until then.
  */
 void spinloop(void) {
 	while(1) {
-		cothread_yield_irq(IRQ_VBLANK);
+		idleWait(0, 0);
 		scanKeys();
 		int keys = keysDown();
 		if(keys) break;	
 	}
 }
 
-/* Delay for a number of seconds, using the RTC as time source.
- * This way we avoid setting up timers. The actual time slept may be
- * a fraction of a second more than requested (e.g. if 1 second is asked 
- * right after the clock ticks, the function will sleep 1 second plus the
- * fraction elapsed right after the clock ticked). Returns 0.
+/* Delay for a number of seconds, halted in between. The name is from when
+ * this polled the RTC every frame; the timebase is finer and needs no
+ * polling. Returns 0.
  */
 unsigned int sleeprtc(unsigned int seconds) {
-	for(time_t t = time(NULL), l=t+seconds+1; t<l; t = time(NULL)) {
-		cothread_yield_irq(IRQ_VBLANK);	// I assume this is more energy efficient
-	}
+	uint64_t end = timebaseUs() + (uint64_t)seconds * 1000000;
+	for(uint64_t now = timebaseUs(); now < end; now = timebaseUs())
+		idleWait(0, end - now);
 	return 0;
 }
 
+/* Halt until something a menu shows could change: a key press, the clock
+ * ticking over, a DNS answer while lookups are in flight, the ARM7's answer
+ * to an RTC write, or a request while serving time.
+ */
+void idleMenu(void) {
+	uint32_t irqMask = 0;
+	if(dnsPending())
+		irqMask |= IRQ_VBLANK | IRQ_FIFO_NOT_EMPTY;
+	if(rtclinkLast()->state == RTCLINK_PENDING)
+		irqMask |= IRQ_FIFO_NOT_EMPTY;
+	if(serverRunning())
+		irqMask |= IRQ_FIFO_NOT_EMPTY;
+	idleWait(irqMask, idleUsToNextSecond());
+}
+
+/* Take the drift built up since the last sync out of the RTC, see
+ * driftCorrect(). It needs a good clock anchor first, so call it every frame
+ * from boot, connected or not, until it returns true.
+ */
+bool correctDrift(void) {
+	static bool corrected = false;
+	if(corrected)
+		return true;
+	timebaseRefine(DRIFT_REFINE_SPIN_US);
+	if(!driftCorrect())
+		return false;
+	driftSave();
+	corrected = true;
+	return true;
+}
+
+/* Finish correctDrift() before exiting: a few seconds for the anchor, and
+ * whatever the RTC write still needs.
+ */
+void correctDriftBeforeExit(void) {
+	uint64_t end = timebaseUs() + DRIFT_EXIT_WAIT_US;
+	while(!correctDrift() && (timebaseUs() < end ||
+							  rtclinkLast()->state == RTCLINK_PENDING)) {
+		cothread_yield_irq(IRQ_VBLANK | IRQ_FIFO_NOT_EMPTY);
+		timebaseUpdate();
+	}
+}
+
+/* Close the sockets and turn the radio off. It is by far the biggest drain on
+ * the battery, and nothing needs it until the next sync.
+ */
+void wifiPowerDown(void) {
+	serverStop();
+	syncShutdown();
+	dnsClose();
+	if(radio == RADIO_OFF)
+		return;
+	Wifi_DisconnectAP();
+	Wifi_DisableWifi();
+	radio = RADIO_OFF;
+	LogInfo(("WiFi off until the next sync."));
+}
+
+/* Turn the radio back on and reconnect, without blocking. Call it every frame
+ * until it returns ASSOCSTATUS_ASSOCIATED or ASSOCSTATUS_CANNOTCONNECT.
+ */
+int wifiPowerUp(void) {
+	if(radio == RADIO_ON)
+		return ASSOCSTATUS_ASSOCIATED;
+	if(radio == RADIO_OFF) {
+		Wifi_EnableWifi();
+		Wifi_AutoConnect();
+		radio = RADIO_CONNECTING;
+	}
+
+	int s = Wifi_AssocStatus();
+	if(s == ASSOCSTATUS_ASSOCIATED) {
+		radio = RADIO_ON;
+		LogInfo(("WiFi back on."));
+		if(dnsInit()) {
+			for(size_t i=0; i<syncConfig.numOfServers; i++)
+				dnsResolveAsync(syncConfig.servers[i]);
+		}
+	}
+	else if(s == ASSOCSTATUS_CANNOTCONNECT) {
+		Wifi_DisableWifi();
+		radio = RADIO_OFF;
+	}
+	return s;
+}
+
+/* Answer other consoles with the time we just got from the server we got it
+ * from. The radio stays on until serving stops.
+ */
+bool serveStart(void) {
+	const struct Fanout * f = syncLastFanout();
+	uint32_t refId = f->best != FANOUT_NONE ? f->servers[f->best].addr : 0;
+	return serverStart(SNTP_DEFAULT_SERVER_PORT, refId,
+		syncProgress()->delayMs);
+}
+
 /* Print IP address information for diagnostics.
  */
 void printIpInfo(void) {
@@ -202,147 +356,131 @@ void printIpInfo(void) {
 	printf("mask   : %s\n", inet_ntoa(mask) );
 	printf("dns1   : %s\n", inet_ntoa(dns1) );
 	printf("dns2   : %s\n", inet_ntoa(dns2) );
-	printf("ntp url: %s\n",ntpurl);
+	for(size_t i=0; i<syncConfig.numOfServers; i++)
+		printf("ntp url: %s\n",syncConfig.servers[i]);
 }
 
-/* Lookup the NTP hostname and print the entry(ies) given by the DNS server.
+/* Lookup the NTP hostnames and print the entry(ies) given by the DNS server.
+ * Both DNS servers are asked at once; the lookups were normally started right
+ * after connecting, so this only waits for whatever is still in flight.
  */
 int printNsLookup(void) {
-	struct hostent * ntphost = gethostbyname(ntpurl);
-	if(ntphost == NULL) {
-		printf("Error: failed to get hostname");
-		return -1;
-	}
+	for(size_t s=0; s<syncConfig.numOfServers; s++) {
+		const struct DnsQuery * q = dnsResolve(syncConfig.servers[s]);
+		if(q == NULL || q->state != DNS_DONE) {
+			printf("Error: failed to get hostname");
+			return -1;
+		}
 
-	/* Assert that we're dealing with IPv4 addresses, 32 bit lengths. */
-	assert(ntphost->h_addrtype == AF_INET);
-	assert(ntphost->h_length >= 4);
-	printf("h_name : %s\n",ntphost->h_name);
-	for(size_t i=0; ntphost->h_aliases[i] != NULL; i++) {
-		printf("h_alias: %s\n",ntphost->h_aliases[i]);
-	}
-	for(int i=0; ntphost->h_addr_list[i] != NULL; i++) {
-		struct in_addr a = *(struct in_addr *)ntphost->h_addr_list[i];
-		printf("h_addr : %s\n", inet_ntoa(a));
+		printf("h_name : %s\n",q->name);
+		for(size_t i=0; i<q->numOfRecords; i++) {
+			struct in_addr a = { .s_addr = htonl(q->records[i].addr) };
+			printf("h_addr : %-15s %lus\n", inet_ntoa(a),
+				(unsigned long)q->records[i].ttl);
+		}
 	}
 	return 0;
 }
 
-/* Print all environment variables. This works on Linux and Unix too! Just copy
- * and paste. Very cool.
- */
-void printEnviron(void)
-{
-	for(size_t i=0; environ[i]!=NULL; i++)
-		printf("%s\n",environ[i]);
-}
-
-
-/* Connect to an NTP server and set the time (assumes locale is set; if not set
- * it defaults to UTC).
+/* Print the round trip time of every server queried by the last fan-out sync.
  */
-int syncTime(int retries)
-{
-	uint8_t netBuffer[SNTP_PACKET_BASE_SIZE];
-	NetworkContext_t netContext = {
-		.udpSocket = socket(AF_INET, SOCK_DGRAM, 0)
-	};
-	SntpServerInfo_t server = {
-		.port = SNTP_DEFAULT_SERVER_PORT,
-		.pServerName = ntpurl,
-		.serverNameLen = strlen(ntpurl)
-	};
-    UdpTransportInterface_t udpTransportIntf = {
-		.pUserContext = &netContext,
-		.sendTo = sntpUdpSend,
-		.recvFrom = sntpUdpRecv
-	};
-	SntpContext_t sntpContext;
-	
-    SntpStatus_t status = Sntp_Init( &sntpContext,
-                                     &server,
-                                     sizeof(server) / sizeof(SntpServerInfo_t),
-                                     NTP_TIMEOUT,
-                                     netBuffer,
-                                     SNTP_PACKET_BASE_SIZE,
-                                     sntpResolveDns,
-                                     sntpGetTime,
-                                     sntpSetTime,
-                                     &udpTransportIntf,
-                                     NULL );
-	if(status != SntpSuccess) {
-		LogError(("Failed to initialize SNTP.\n"));
-		return -1;
-	}
-
-	int i,j;
-	for(i=0, j=0; i<retries; i++) {
-		status = Sntp_SendTimeRequest( &sntpContext,
-										rand() % UINT32_MAX,
-										NTP_SEND_WAIT_TIME_MS );
-		if ( status != SntpSuccess ) continue;
-		do {
-            status = Sntp_ReceiveTimeResponse( &sntpContext, NTP_RECEIVE_WAIT_TIME_MS );
-        } while( status == SntpNoResponseReceived );
-		if ( status != SntpSuccess ) continue;
-		break;
-	}
-
-	if(i>=retries || j>=retries) {
-		LogError(("Failed to request SNTP time.\n"));
-		return -1;
-	}
-	else 
-		return 0;
+void printFanout(void) {
+	const struct Fanout * f = syncLastFanout();
+	for(size_t i=0; i<f->numOfServers; i++) {
+		struct in_addr a = { .s_addr = htonl(f->servers[i].addr) };
+		if(f->servers[i].latencyMs >= 0)
+			printf("%-15s %4li ms%s\n", inet_ntoa(a),
+				(long)f->servers[i].latencyMs, i==f->best? " *" : "");
+		else
+			printf("%-15s    - ms\n", inet_ntoa(a));
+	}
 }
 
-/* Display the timezone setting dialog. 
+/* Display the timezone setting dialog. Select switches between a fixed UTC
+ * offset and the named zones built into the ROM.
  * @returns an `enum Menu` with the next menu that should be displayed.
  */
 enum Menu displayTZMenu(void)
 {
-	enum Selection {s_hour, s_minute};
+	enum Selection {s_hour, s_minute, s_zone};
 
 	static enum Selection sel = s_hour;
 	static struct Tz tz = {.hour=0, .minute=0};
+	static const struct TzZone * zone = NULL;
+	if(zone == NULL) {
+		/* Start from the setting loaded at boot, if any. */
+		zone = tzCurrentZone();
+		if(zone != NULL) {
+			sel = s_zone;
+		}
+		else {
+			int32_t offset = tzOffsetAt(0);
+			tz.hour = offset / 3600;
+			tz.minute = labs(offset) / 60 % 60;
+		}
+	}
+	if(zone == NULL) zone = tzFind("UTC");
+	if(zone == NULL) zone = &tzZones[0];
 
-	cothread_yield_irq(IRQ_VBLANK);
-	printf("\x1b[2J"); // Clear console
 	const int coord_x[2] = {
 		5, 8
 	};
-	printf("\n\nTimezone:\n\n");
-	printf("\x1b[%dC^\n", coord_x[sel]);
-	printf("UTC%+03i:%02u\n", tz.hour, tz.minute%60);
-    printf("\x1b[%dCv\n", coord_x[sel]);
+	screenBegin();
+	screenAt(2, 0);
+	screenPrintf("Timezone:\n\n");
+	if(sel == s_zone) {
+		const struct TzType * type = tzTypeAt(zone, time(NULL) - driftRtcOffsetSec());
+		long offset = type->utcOffset / 60;
+		screenPrintf("^\n%s\nv\n", zone->name);
+		screenPrintf("%s, UTC%c%02li:%02li\n", tzAbbrev(type),
+			offset < 0 ? '-' : '+', labs(offset) / 60, labs(offset) % 60);
+	}
+	else {
+		screenPrintf("%*s^\n", coord_x[sel], "");
+		screenPrintf("UTC%+03i:%02u\n", tz.hour, tz.minute%60);
+		screenPrintf("%*sv\n", coord_x[sel], "");
+	}
 
-	printf(	"\n\n\n\n\n\n\n\n\n\n\n\n"
-			"Press A to sync time.\n"
-			"Press Start to exit.");
+	screenAt(19, 0);
+	screenPrintf("Press A to sync time.\n"
+			"Press Select for %s.\n"
+			"Press Start to exit.",
+			sel == s_zone ? "a UTC offset" : "named zones");
+	screenEnd();
 
+	idleMenu();
 	scanKeys();
 	uint16_t keys = keysDownRepeat();
 
 	if(keys & KEY_A) {
-		tz.minute = tz.minute % 60;
-		
-		snprintf(	ndsntp_env_tz,sizeof(ndsntp_env_tz),
-					"TZ=<UTC%+03i%02u>%+03i:%02u",
-					tz.hour, tz.minute, -tz.hour, tz.minute);
-					// POSIX uses the opposite sign compared to ISO
-		tzset();	// Change the system's timezone
-		IF_DIAGNOSTICS {
-			printf("\n");
-			printEnviron();
-			spinloop();
+		if(sel == s_zone) {
+			tzSetZone(zone);
 		}
+		else {
+			tz.minute = tz.minute % 60;
+			tzSetFixed(tz.hour * 3600 + (tz.hour < 0 ? -1 : 1) * tz.minute * 60);
+		}
+		tzSave();
 		IF_DIAGNOSTICS {
-			printf("%s\n%s\n",tzname[0],tzname[1]);
+			printf("\nUTC%+li s\n",
+				(long)tzOffsetAt(time(NULL) - driftRtcOffsetSec()));
 			spinloop();
 		}
 		
 		return MENU_SYNCING;
 	}
+	else if(keys & KEY_SELECT) {
+		sel = sel == s_zone ? s_hour : s_zone;
+	}
+	else if(sel == s_zone) {
+		size_t i = zone - tzZones;
+		if(keys & KEY_UP)
+			zone = &tzZones[i == 0 ? tzNumOfZones - 1 : i - 1];
+		else if(keys & KEY_DOWN)
+			zone = &tzZones[i + 1 == tzNumOfZones ? 0 : i + 1];
+		else if(keys & KEY_START)
+			return MENU_EXIT;
+	}
 	else if(keys & KEY_LEFT) {
 		if(sel>s_hour) sel--;
 	}
@@ -360,6 +498,8 @@ enum Menu displayTZMenu(void)
 				else if(tz.minute >= 60) tz.minute += 1;
 				else tz.minute += 15;
 				break;
+			default:
+				break;
 		}
 	}
 	else if(keys & KEY_DOWN) {
@@ -373,6 +513,8 @@ enum Menu displayTZMenu(void)
 				else if(tz.minute > 60) tz.minute -= 1;
 				else tz.minute -= 15;
 				break;
+			default:
+				break;
 		}
 	}
 	else if(keys & KEY_START) {
@@ -383,25 +525,213 @@ enum Menu displayTZMenu(void)
 
 }
 
+/* Display the progress of the sync while advancing it. The sync starts when
+ * this menu is entered and B cancels it.
+ * @returns an `enum Menu` with the next menu that should be displayed.
+ */
+enum Menu displaySyncingMenu(void)
+{
+	/* The radio is off between syncs; reconnect first. */
+	if(radio != RADIO_ON) {
+		int s = wifiPowerUp();
+		if(s == ASSOCSTATUS_CANNOTCONNECT) {
+			printf("WFC connection failed. Check your wireless settings.\n");
+			sleeprtc(2);
+			return MENU_TZ;
+		}
+		if(s != ASSOCSTATUS_ASSOCIATED) {
+			cothread_yield_irq(IRQ_VBLANK);
+			scanKeys();
+			if(keysDown() & KEY_B) {
+				wifiPowerDown();
+				return MENU_TZ;
+			}
+			screenBegin();
+			screenAt(2, 0);
+			screenPrintf("Connecting to WLAN...");
+			screenAt(18, 0);
+			screenPrintf("Press B to cancel.");
+			screenEnd();
+			return MENU_SYNCING;
+		}
+	}
+
+	/* Nobody gets our time while the RTC is being set. */
+	const struct SyncProgress * p = syncProgress();
+	if(p->state < SYNC_RESOLVE || p->state > SYNC_COMMIT) {
+		serverStop();
+		syncStart(config()->retries);
+	}
+
+	/* Sleeps until the VBlank, or until a packet arrives while we wait for
+	 * a response. */
+	cothread_yield_irq(syncWaitIrq());
+	enum SyncState state = syncStep();
+	scanKeys();
+
+	if(state == SYNC_DONE || state == SYNC_FAILED) {
+		if(state == SYNC_FAILED && p->samples == 0) {
+			printf("Couldn't connect to time server(s)!\n");
+		}
+		else if(state == SYNC_FAILED) {
+			printf("Couldn't set the clock!\n");
+		}
+		addrcacheSave();
+		driftSave();
+		if(!(state == SYNC_DONE && serve && serveStart()))
+			wifiPowerDown();
+		if(headless && !serverRunning()) {
+			LogInfo(("Headless sync %s.",
+				state == SYNC_DONE ? "done" : "failed"));
+			return MENU_EXIT;
+		}
+		IF_DIAGNOSTICS {
+			if(syncConfig.mode != SYNC_SEQUENTIAL) printFanout();
+			if(p->samples > 0)
+				printf("offset %lli ms, delay %lli ms\n"
+					"spread %lli ms over %i samples\n",
+					(long long)p->offsetMs, (long long)p->delayMs,
+					(long long)p->spreadMs, p->samples);
+			const struct RtcLinkStats * r = rtclinkStats();
+			if(r->numOfAcks > 0)
+				printf("RTC ack %lu us (%lu to %lu us)\n",
+					(unsigned long)r->lastRttUs, (unsigned long)r->minRttUs,
+					(unsigned long)r->maxRttUs);
+			sleeprtc(2);
+			printf("\x1b[2J"); // Clear console
+			logPrintTail(8);
+			spinloop();
+		}
+		return MENU_SYNCED;
+	}
+	if(keysDown() & KEY_B) {
+		syncCancel();
+		return MENU_TZ;
+	}
+
+	screenBegin();
+	screenAt(2, 0);
+	screenPrintf("Syncing: %s\n", syncStateName(state));
+	screenPrintf("Attempt %i of %i, %lu ms\n", p->attempt+1, p->retries,
+		(unsigned long)((timebaseUs() - p->startUs) / 1000));
+	screenPrintf("Sample %i of %u\n", p->samples, (unsigned)syncConfig.burst);
+	screenAt(18, 0);
+	screenPrintf("Press B to cancel.");
+	screenEnd();
+	return MENU_SYNCING;
+}
+
 enum Menu displaySyncedMenu(void)
 {
-	char str[100];
-	time_t t = time(NULL);
-	struct tm *tmp = RTC_IS_GMT? localtime(&t) : gmtime(&t);
-	cothread_yield_irq(IRQ_VBLANK);
-	printf("\x1b[2J"); // Clear console
-	printf("\n\nCurrent time:\n\n\n");
-	if (strftime(str, sizeof(str), "%Y-%m-%dT%H:%M:%S%z", tmp) == 0)
-		snprintf(str, sizeof(str), "Failed to get time");
-	printf("%s\n", str);
-	printf("\n\n\n\n\n\n\n\n\n\n\n\n");
-	printf("Press A to sync again.\n"
+	/* The text only changes when the second ticks, or after a sync. */
+	static char timeLine[SCREEN_COLS + 1];
+	static char driftLines[3 * (SCREEN_COLS + 1)];
+	static char breakdown[SCREEN_ROWS * (SCREEN_COLS + 1)];
+	static char idleLine[SCREEN_COLS + 1];
+	static char serveLine[SCREEN_COLS + 1];
+	static time_t formattedSec = -1;
+	static uint64_t shownUs;
+	bool newSync = syncProgress()->endUs != shownUs;
+
+	time_t rtc = time(NULL);
+	if(rtc != formattedSec || newSync) {
+		char str[40];
+		formattedSec = rtc;
+
+		/* Work in UTC and convert with the zone, whatever the RTC holds. */
+		time_t utc = rtc - driftRtcOffsetSec();
+		long offset = tzOffsetAt(utc) / 60;
+		time_t t = utc + offset * 60;
+		if (strftime(str, sizeof(str), "%Y-%m-%dT%H:%M:%S", gmtime(&t)) == 0)
+			snprintf(str, sizeof(str), "Failed to get time");
+		snprintf(timeLine, sizeof(timeLine), "%s%c%02li%02li", str,
+			offset < 0 ? '-' : '+', labs(offset) / 60, labs(offset) % 60);
+
+		const struct DriftState * d = driftState();
+		size_t n = 0;
+		if(d->numOfEstimates > 0)
+			n += snprintf(driftLines, sizeof(driftLines),
+				"RTC drift: %+li.%02li ppm\n", (long)d->ppb / 1000,
+				labs((long)d->ppb % 1000) / 10);
+		else
+			n += snprintf(driftLines, sizeof(driftLines),
+				"RTC drift: not known yet\n");
+		time_t next = driftNextSyncSec();
+		next += tzOffsetAt(next);
+		if (strftime(str, sizeof(str), "%Y-%m-%d %H:%M", gmtime(&next)) != 0)
+			n += snprintf(driftLines + n, sizeof(driftLines) - n,
+				"Sync again by %s\n", str);
+		uint64_t bootUs;
+		if(phaseSpanUs(PHASE_BOOT, PHASE_UI_SYNCED, &bootUs))
+			snprintf(driftLines + n, sizeof(driftLines) - n,
+				"Boot to synced: %lu.%lu s\n",
+				(unsigned long)(bootUs / 1000000),
+				(unsigned long)(bootUs / 100000 % 10));
+
+		phaseFormatBreakdown(breakdown, sizeof(breakdown));
+
+		/* How much of the time since boot the ARM9 spent halted. */
+		const struct IdleStats * idle = idleStats();
+		uint64_t spanUs = timebaseUs() - idle->sinceUs;
+		if(spanUs > 0)
+			snprintf(idleLine, sizeof(idleLine), "Asleep %u%%, %lu wakeups/s",
+				(unsigned)(idle->sleptUs * 100 / spanUs),
+				(unsigned long)((uint64_t)idle->wakeups * 1000000 / spanUs));
+
+		const struct ServerStats * s = serverStats();
+		if(serverRunning())
+			snprintf(serveLine, sizeof(serveLine), "Serving: %lu/s, %lu in all",
+				(unsigned long)s->perSecond, (unsigned long)s->numOfReplies);
+		else
+			serveLine[0] = '\0';
+	}
+
+	screenBegin();
+	screenAt(2, 0);
+	screenPrintf("Current time:");
+	screenAt(5, 0);
+	screenPrintf("%s", timeLine);
+	IF_DIAGNOSTICS {
+		/* Where the time went, from boot to this screen. */
+		screenAt(7, 0);
+		screenPrintf("%s", breakdown);
+		screenAt(18, 0);
+		screenPrintf("%s", idleLine);
+	}
+	else {
+		screenAt(8, 0);
+		screenPrintf("%s", driftLines);
+		screenAt(14, 0);
+		screenPrintf("%s", serveLine);
+	}
+	screenAt(19, 0);
+	screenPrintf("Press A to sync again.\n"
 		"Press B to go back.\n"
-		"Press Start to exit.\n");
+		"Press Select to %s.\n"
+		"Press Start to exit.",
+		serverRunning() ? "stop serving" : "serve time");
+	screenEnd();
+
+	/* Once per sync, now that its result is on screen. */
+	if(newSync) {
+		shownUs = syncProgress()->endUs;
+		phaseMark(PHASE_UI_SYNCED, 0);
+		phaseSave();
+		formattedSec = -1;
+	}
+
+	idleMenu();
 	scanKeys();
 	int keys = keysDown();
 	if(keys & KEY_START) return MENU_EXIT;
 	if(keys & KEY_A) return MENU_SYNCING;
 	if(keys & KEY_B) return MENU_TZ;
+	if(keys & KEY_SELECT) {
+		/* Serve fresh time: sync first, which turns the radio back on. */
+		serve = !serverRunning();
+		if(serve) return MENU_SYNCING;
+		wifiPowerDown();
+		formattedSec = -1;
+	}
 	return MENU_SYNCED;
 }
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include "ntptime.h"
+
+/* Division that rounds towards minus infinity. */
+static int64_t floorDiv(int64_t a, int64_t b)
+{
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+int64_t ntptimeToUnixUs(const SntpTimestamp_t * pTime)
+{
+    int64_t s = pTime->seconds;
+    if(s < NTPTIME_2000)
+        s += NTPTIME_ERA;
+    int64_t us = ((uint64_t)pTime->fractions * 1000000) >> 32;
+    return (s - NTPTIME_UNIX_EPOCH) * 1000000 + us;
+}
+
+void ntptimeFromUnixUs(int64_t unixUs, SntpTimestamp_t * pTime)
+{
+    int64_t s = floorDiv(unixUs, 1000000);
+    int64_t us = unixUs - s * 1000000;
+    pTime->seconds = (uint32_t)(s + NTPTIME_UNIX_EPOCH);    // Wraps into the era
+    pTime->fractions = ((uint64_t)us << 32) / 1000000;
+}
+
+/* These two are Howard Hinnant's algorithms. Years start in March, so the
+ * leap day comes last and months have a fixed pattern of lengths. An era here
+ * is the 400-year Gregorian cycle of 146097 days.
+ */
+int64_t ntptimeDaysFromCivil(int32_t year, uint32_t month, uint32_t day)
+{
+    int64_t y = (int64_t)year - (month <= 2);
+    int64_t era = floorDiv(y, 400);
+    int64_t yoe = y - era * 400;                                    // [0, 399]
+    int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
+    return era * 146097 + doe - 719468;
+}
+
+void ntptimeCivilFromDays(int64_t days, int32_t * pYear, uint32_t * pMonth,
+                          uint32_t * pDay)
+{
+    days += 719468;
+    int64_t era = floorDiv(days, 146097);
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    uint32_t month = mp < 10 ? mp + 3 : mp - 9;
+    *pDay = doy - (153 * mp + 2) / 5 + 1;
+    *pMonth = month;
+    *pYear = yoe + era * 400 + (month <= 2);
+}
+
+bool ntptimeToRtc(int64_t unixSec, rtcTimeAndDate * pRtc)
+{
+    int64_t days = floorDiv(unixSec, 86400);
+    int64_t secs = unixSec - days * 86400;
+
+    int32_t year;
+    uint32_t month, day;
+    ntptimeCivilFromDays(days, &year, &month, &day);
+    if(year < 2000)
+        return false;
+
+    pRtc->year = year % 100;
+    pRtc->month = month;
+    pRtc->day = day;
+    pRtc->weekday = (days + 4) - floorDiv(days + 4, 7) * 7;  // 1970-01-01 was a Thursday
+    pRtc->hours = secs / 3600;
+    pRtc->minutes = secs / 60 % 60;
+    pRtc->seconds = secs % 60;
+    return true;
+}
+
+int64_t ntptimeFromRtc(const rtcTimeAndDate * pRtc)
+{
+    int64_t days = ntptimeDaysFromCivil(2000 + pRtc->year, pRtc->month,
+                                        pRtc->day);
+    return days * 86400 + pRtc->hours * 3600 + pRtc->minutes * 60
+           + pRtc->seconds;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdio.h>
+#include <time.h>
+#include "core_sntp_config.h"
+#include "phase.h"
+#include "storage.h"
+#include "timebase.h"
+
+static struct PhaseEvent phaseEvents[PHASE_MAX_EVENTS];
+static uint32_t phaseTotal;         /* Events ever recorded */
+static uint32_t phaseSaved;         /* ...and written to PHASE_FILE */
+static time_t phaseBootSec;
+
+static const char * const phaseNames[PHASE_COUNT] = {
+    [PHASE_BOOT]                = "boot",
+    [PHASE_WIFI_SEARCHING]      = "wifi-searching",
+    [PHASE_WIFI_ASSOCIATING]    = "wifi-associating",
+    [PHASE_WIFI_AUTHENTICATING] = "wifi-authenticating",
+    [PHASE_WIFI_DHCP]           = "wifi-dhcp",
+    [PHASE_WIFI_ASSOCIATED]     = "wifi-associated",
+    [PHASE_DNS_QUERY]           = "dns-query",
+    [PHASE_DNS_ANSWER]          = "dns-answer",
+    [PHASE_SYNC_START]          = "sync-start",
+    [PHASE_NTP_SEND]            = "ntp-send",
+    [PHASE_NTP_RECV]            = "ntp-recv",
+    [PHASE_SYNC_APPLY]          = "sync-apply",
+    [PHASE_RTC_SEND]            = "rtc-send",
+    [PHASE_RTC_ACK]             = "rtc-ack",
+    [PHASE_SYNC_DONE]           = "sync-done",
+    [PHASE_SYNC_FAILED]         = "sync-failed",
+    [PHASE_UI_SYNCED]           = "ui-synced",
+};
+
+void phaseInit(void)
+{
+    phaseTotal = 0;
+    phaseSaved = 0;
+    phaseBootSec = time(NULL);
+    phaseMark(PHASE_BOOT, 0);
+}
+
+void phaseMark(enum Phase phase, uint16_t arg)
+{
+    struct PhaseEvent * e = &phaseEvents[phaseTotal % PHASE_MAX_EVENTS];
+    e->us = timebaseUs();
+    e->phase = phase;
+    e->arg = arg;
+    phaseTotal++;
+}
+
+size_t phaseCount(void)
+{
+    return phaseTotal < PHASE_MAX_EVENTS ? phaseTotal : PHASE_MAX_EVENTS;
+}
+
+const struct PhaseEvent * phaseGet(size_t i)
+{
+    uint32_t first = phaseTotal - phaseCount();
+    return &phaseEvents[(first + i) % PHASE_MAX_EVENTS];
+}
+
+const char * phaseName(enum Phase phase)
+{
+    if(phase >= PHASE_COUNT)
+        return "?";
+    return phaseNames[phase];
+}
+
+bool phaseSpanUs(enum Phase from, enum Phase to, uint64_t * pUs)
+{
+    size_t n = phaseCount();
+    size_t i = n;
+    while(i > 0 && phaseGet(i - 1)->phase != from)
+        i--;
+    if(i == 0)
+        return false;
+    uint64_t start = phaseGet(i - 1)->us;
+
+    for(; i < n; i++) {
+        const struct PhaseEvent * e = phaseGet(i);
+        if(e->phase == to) {
+            *pUs = e->us - start;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t phaseFormatBreakdown(char * pBuffer, size_t size)
+{
+    static const struct {
+        const char * label;
+        enum Phase from, to;
+    } spans[] = {
+        { "wifi",           PHASE_BOOT,         PHASE_WIFI_ASSOCIATED },
+        { " dhcp",          PHASE_WIFI_DHCP,    PHASE_WIFI_ASSOCIATED },
+        { "dns",            PHASE_DNS_QUERY,    PHASE_DNS_ANSWER },
+        { "to first send",  PHASE_SYNC_START,   PHASE_NTP_SEND },
+        { "ntp round trip", PHASE_NTP_SEND,     PHASE_NTP_RECV },
+        { "all samples",    PHASE_SYNC_START,   PHASE_SYNC_APPLY },
+        { "rtc write",      PHASE_RTC_SEND,     PHASE_RTC_ACK },
+        { "to screen",      PHASE_SYNC_DONE,    PHASE_UI_SYNCED },
+        { "boot to synced", PHASE_BOOT,         PHASE_SYNC_DONE },
+    };
+
+    size_t used = 0;
+    for(size_t i=0; i<sizeof(spans)/sizeof(spans[0]); i++) {
+        uint64_t us;
+        if(!phaseSpanUs(spans[i].from, spans[i].to, &us))
+            continue;
+        int n = snprintf(used < size ? pBuffer + used : NULL,
+                         used < size ? size - used : 0,
+                         "%-15s %7lu.%lu ms\n", spans[i].label,
+                         (unsigned long)(us / 1000), (unsigned long)(us / 100 % 10));
+        used += n > 0 ? n : 0;
+    }
+    if(used == 0 && size > 0)
+        pBuffer[0] = '\0';
+    return used;
+}
+
+void phasePrintBreakdown(void)
+{
+    char text[512];
+    phaseFormatBreakdown(text, sizeof(text));
+    printf("%s", text);
+}
+
+bool phaseSave(void)
+{
+    if(phaseSaved == phaseTotal)
+        return true;
+
+    /* Peek at the size to know whether the header is needed. */
+    FILE * f = storageOpen(PHASE_FILE, "a");
+    if(f == NULL)
+        return false;
+    fseek(f, 0, SEEK_END);
+    if(ftell(f) == 0)
+        fprintf(f, "boot,us,phase,arg\n");
+
+    /* Events overwritten before they were saved are lost. */
+    uint32_t first = phaseTotal - phaseCount();
+    if(phaseSaved < first)
+        phaseSaved = first;
+    for(; phaseSaved < phaseTotal; phaseSaved++) {
+        const struct PhaseEvent * e = &phaseEvents[phaseSaved % PHASE_MAX_EVENTS];
+        fprintf(f, "%lli,%llu,%s,%u\n", (long long)phaseBootSec,
+                (unsigned long long)e->us, phaseName(e->phase), e->arg);
+    }
+
+    if(fclose(f) != 0) {
+        LogWarn(("Could not save the phase log."));
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdlib.h>
+#include "retry.h"
+
+void retryInit(struct RetryState * pRetry)
+{
+    pRetry->srttMs = 0;
+    pRetry->rttvarMs = 0;
+    pRetry->failures = 0;
+}
+
+void retrySample(struct RetryState * pRetry, uint32_t rttMs)
+{
+    if(pRetry->srttMs == 0) {
+        pRetry->srttMs = rttMs ? rttMs : 1;
+        pRetry->rttvarMs = rttMs / 2;
+    }
+    else {
+        /* RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, SRTT = 7/8 SRTT + 1/8 R */
+        uint32_t err = rttMs > pRetry->srttMs ? rttMs - pRetry->srttMs
+                                              : pRetry->srttMs - rttMs;
+        pRetry->rttvarMs = (3 * pRetry->rttvarMs + err) / 4;
+        pRetry->srttMs = (7 * pRetry->srttMs + rttMs) / 8;
+        if(pRetry->srttMs == 0)
+            pRetry->srttMs = 1;
+    }
+    pRetry->failures = 0;
+}
+
+uint32_t retryTimeoutMs(const struct RetryState * pRetry)
+{
+    uint32_t timeout = RETRY_INITIAL_TIMEOUT_MS;
+    if(pRetry->srttMs != 0)
+        timeout = pRetry->srttMs + 4 * pRetry->rttvarMs;
+
+    /* Karn: after a timeout the estimate may be stale, so back the timeout
+     * off too until a response comes back. */
+    for(uint32_t i=0; i<pRetry->failures && timeout < RETRY_MAX_TIMEOUT_MS; i++)
+        timeout *= 2;
+
+    if(timeout < RETRY_MIN_TIMEOUT_MS)
+        timeout = RETRY_MIN_TIMEOUT_MS;
+    if(timeout > RETRY_MAX_TIMEOUT_MS)
+        timeout = RETRY_MAX_TIMEOUT_MS;
+    return timeout;
+}
+
+uint32_t retryFailed(struct RetryState * pRetry, uint32_t minMs)
+{
+    uint32_t backoff = RETRY_BACKOFF_BASE_MS;
+    for(uint32_t i=0; i<pRetry->failures && backoff < RETRY_BACKOFF_MAX_MS; i++)
+        backoff *= 2;
+    if(backoff > RETRY_BACKOFF_MAX_MS)
+        backoff = RETRY_BACKOFF_MAX_MS;
+    pRetry->failures++;
+
+    /* Half fixed, half random. */
+    backoff = backoff / 2 + rand() % (backoff / 2 + 1);
+    return backoff > minMs ? backoff : minMs;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <nds.h>
+#include "ndsntp_fifo.h"
+#include "ntptime.h"
+#include "phase.h"
+#include "rtclink.h"
+#include "timebase.h"
+
+static struct RtcLinkWrite rtclinkCurrent;
+static struct RtcLinkStats rtclinkStatistics;
+static uint32_t rtclinkSeq;
+
+static void rtclinkAnswered(const struct NdsntpRtcReply * pReply)
+{
+    struct RtcLinkWrite * w = &rtclinkCurrent;
+    w->answerUs = timebaseUs();
+    uint64_t elapsed = w->answerUs - w->sentUs;
+    uint32_t rtt = elapsed > w->delayUs ? elapsed - w->delayUs : 0;
+
+    w->rttUs = rtt;
+    w->readback = pReply->readback;
+    if(pReply->status != NDSNTP_RTC_OK) {
+        w->state = RTCLINK_FAILED;
+    }
+    else {
+        /* The ARM7 reads the RTC right after writing it, so at most one
+         * second can have gone by. */
+        int64_t diff = ntptimeFromRtc(&w->readback) - ntptimeFromRtc(&w->time);
+        w->state = (diff == 0 || diff == 1) ? RTCLINK_DONE : RTCLINK_MISMATCH;
+    }
+    phaseMark(PHASE_RTC_ACK, w->state);
+
+    struct RtcLinkStats * st = &rtclinkStatistics;
+    if(st->numOfAcks == 0 || rtt < st->minRttUs)
+        st->minRttUs = rtt;
+    if(rtt > st->maxRttUs)
+        st->maxRttUs = rtt;
+    st->lastRttUs = rtt;
+    st->numOfAcks++;
+}
+
+const struct RtcLinkWrite * rtclinkWriteAsync(const rtcTimeAndDate * pTime,
+                                              uint32_t delayUs)
+{
+    struct RtcLinkWrite * w = &rtclinkCurrent;
+    if(w->state == RTCLINK_PENDING)
+        return NULL;
+
+    struct NdsntpRtcRequest request = {
+        .seq = ++rtclinkSeq,
+        .delayUs = delayUs,
+        .time = *pTime,
+    };
+    w->seq = request.seq;
+    w->time = *pTime;
+    w->delayUs = delayUs;
+    w->answerUs = 0;
+    w->rttUs = 0;
+    w->sentUs = timebaseUs();
+    w->state = RTCLINK_PENDING;
+    rtclinkStatistics.numOfWrites++;
+    phaseMark(PHASE_RTC_SEND, delayUs / 1000);
+
+    if(!fifoSendDatamsg(FIFO_NDSNTP, sizeof(request), (void *)&request))
+        w->state = RTCLINK_FAILED;
+    return w;
+}
+
+void rtclinkPoll(void)
+{
+    struct RtcLinkWrite * w = &rtclinkCurrent;
+
+    while(fifoCheckDatamsg(FIFO_NDSNTP)) {
+        struct NdsntpRtcReply reply;
+        if(fifoCheckDatamsgLength(FIFO_NDSNTP) != sizeof(reply)) {
+            uint8_t discard[FIFO_MAX_DATA_BYTES];
+            fifoGetDatamsg(FIFO_NDSNTP, sizeof(discard), discard);
+            continue;
+        }
+        fifoGetDatamsg(FIFO_NDSNTP, sizeof(reply), (void *)&reply);
+        if(w->state == RTCLINK_PENDING && reply.seq == w->seq)
+            rtclinkAnswered(&reply);
+    }
+
+    if(w->state == RTCLINK_PENDING
+       && timebaseUs() - w->sentUs >= w->delayUs + RTCLINK_TIMEOUT_MS * 1000) {
+        w->state = RTCLINK_TIMEOUT;
+        rtclinkStatistics.numOfTimeouts++;
+        phaseMark(PHASE_RTC_ACK, w->state);
+    }
+}
+
+const struct RtcLinkWrite * rtclinkWrite(const rtcTimeAndDate * pTime,
+                                         uint32_t delayUs)
+{
+    const struct RtcLinkWrite * w = rtclinkWriteAsync(pTime, delayUs);
+    while(w != NULL && w->state == RTCLINK_PENDING) {
+        /* The answer comes in through the FIFO; VBlank is there to make
+         * sure the timeout is noticed. */
+        cothread_yield_irq(IRQ_VBLANK | IRQ_FIFO_NOT_EMPTY);
+        rtclinkPoll();
+    }
+    return w;
+}
+
+const struct RtcLinkWrite * rtclinkLast(void)
+{
+    return &rtclinkCurrent;
+}
+
+const struct RtcLinkStats * rtclinkStats(void)
+{
+    return &rtclinkStatistics;
+}
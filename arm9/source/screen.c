@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "screen.h"
+
+static PrintConsole * console;
+static char back[SCREEN_ROWS][SCREEN_COLS];     /* Being drawn */
+static char front[SCREEN_ROWS][SCREEN_COLS];    /* On the console */
+static bool frontValid = false;
+static int cursorRow, cursorCol;
+
+void screenInit(PrintConsole * pConsole)
+{
+    console = pConsole;
+    frontValid = false;
+}
+
+void screenBegin(void)
+{
+    memset(back, ' ', sizeof(back));
+    cursorRow = 0;
+    cursorCol = 0;
+}
+
+void screenAt(int row, int col)
+{
+    cursorRow = row;
+    cursorCol = col;
+}
+
+void screenPrintf(const char * format, ...)
+{
+    char text[SCREEN_ROWS * SCREEN_COLS + 1];
+    va_list ap;
+
+    va_start(ap, format);
+    vsnprintf(text, sizeof(text), format, ap);
+    va_end(ap);
+
+    for(const char * c = text; *c != '\0'; c++) {
+        if(*c == '\n' || cursorCol >= SCREEN_COLS) {
+            cursorRow++;
+            cursorCol = 0;
+            if(*c == '\n')
+                continue;
+        }
+        if(cursorRow >= 0 && cursorRow < SCREEN_ROWS && cursorCol >= 0)
+            back[cursorRow][cursorCol] = *c;
+        cursorCol++;
+    }
+}
+
+void screenEnd(void)
+{
+    if(!frontValid) {
+        printf("\x1b[2J");
+        memset(front, ' ', sizeof(front));
+        frontValid = true;
+    }
+
+    for(int row=0; row<SCREEN_ROWS; row++) {
+        if(memcmp(back[row], front[row], SCREEN_COLS) == 0)
+            continue;
+
+        /* Rewrite the row from its first change to its last. The console
+         * only wraps before printing the next character, so writing the
+         * last column doesn't scroll. */
+        int first = 0, last = SCREEN_COLS - 1;
+        while(back[row][first] == front[row][first])
+            first++;
+        while(back[row][last] == front[row][last])
+            last--;
+        console->cursorY = row;
+        console->cursorX = first;
+        printf("%.*s", last - first + 1, &back[row][first]);
+        memcpy(&front[row][first], &back[row][first], last - first + 1);
+    }
+}
+
+void screenInvalidate(void)
+{
+    frontValid = false;
+}
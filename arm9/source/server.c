@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <core_sntp_client.h>
+#include "auth.h"
+#include "core_sntp_callbacks.h"
+#include "core_sntp_config.h"
+#include "server.h"
+#include "timebase.h"
+
+#define SERVER_CLIENT_MODE  3
+#define SERVER_MODE         4
+/* About a millisecond. The timer is finer, but the RTC anchor isn't. */
+#define SERVER_PRECISION    -10
+/* How fast an unsynced clock is assumed to wander, as in RFC 5905. */
+#define SERVER_PHI_PPM      15
+
+static int udpSocket = -1;
+static uint8_t request[AUTH_PACKET_SIZE];
+static uint8_t reply[AUTH_PACKET_SIZE];    /* Template, filled in per request */
+static struct ServerStats stats;
+static uint64_t referenceUs;    /* timebaseUs() when serving started */
+static uint64_t windowUs;       /* ...and when the current second started */
+static uint32_t inWindow;       /* Requests since then */
+
+static void storeBe32(uint8_t * p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void storeTimestamp(uint8_t * p, const SntpTimestamp_t * pTime)
+{
+    storeBe32(p, pTime->seconds);
+    storeBe32(p + 4, pTime->fractions);
+}
+
+/* NTP short format, 16.16 seconds. */
+static uint32_t shortFromUs(uint64_t us)
+{
+    return (uint32_t)((us << 16) / 1000000);
+}
+
+/* How far off our clock may be: the uncertainty of the RTC anchor, plus
+ * whatever it drifted since the sync. */
+static void serverUpdateDispersion(void)
+{
+    uint64_t sinceUs = timebaseUs() - referenceUs;
+    uint64_t us = timebaseWindowUs() + sinceUs * SERVER_PHI_PPM / 1000000;
+    storeBe32(reply + 8, shortFromUs(us));
+}
+
+bool serverStart(uint16_t port, uint32_t refId, uint32_t rootDelayMs)
+{
+    serverStop();
+    udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if(udpSocket < 0) {
+        LogError(("Could not open the server socket. Errno was %i", errno));
+        return false;
+    }
+    struct sockaddr_in addri = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if(bind(udpSocket, (struct sockaddr *)&addri, sizeof(addri)) < 0) {
+        LogError(("Could not serve on port %u. Errno was %i", port, errno));
+        closesocket(udpSocket);
+        udpSocket = -1;
+        return false;
+    }
+
+    /* Everything but the timestamps, the poll and the version. */
+    SntpTimestamp_t now;
+    sntpGetTime(&now);
+    memset(reply, 0, sizeof(reply));
+    reply[1] = SERVER_STRATUM;
+    reply[3] = (uint8_t)SERVER_PRECISION;
+    storeBe32(reply + 4, shortFromUs((uint64_t)rootDelayMs * 1000));
+    storeBe32(reply + 12, refId);
+    storeTimestamp(reply + 16, &now);
+
+    memset(&stats, 0, sizeof(stats));
+    referenceUs = windowUs = timebaseUs();
+    inWindow = 0;
+    serverUpdateDispersion();
+    LogInfo(("Serving time on port %u.", port));
+    return true;
+}
+
+/* Answers the `length` byte request in `request`, received at `pRxTime`. */
+static void serverReply(size_t length, const struct sockaddr_in * pFrom,
+                        const SntpTimestamp_t * pRxTime)
+{
+    uint8_t version = (request[0] >> 3) & 7;
+    if(length < SNTP_PACKET_BASE_SIZE ||
+       (request[0] & 7) != SERVER_CLIENT_MODE || version < 1 || version > 4) {
+        stats.numOfIgnored++;
+        return;
+    }
+    stats.numOfRequests++;
+    inWindow++;
+
+    reply[0] = NoLeapSecond << 6 | version << 3 | SERVER_MODE;
+    reply[2] = request[2];                      /* Poll */
+    memcpy(reply + 24, request + 40, 8);        /* Originate */
+    storeTimestamp(reply + 32, pRxTime);
+
+    SntpTimestamp_t txTime;
+    sntpGetTime(&txTime);
+    storeTimestamp(reply + 40, &txTime);
+
+    size_t replyLength = SNTP_PACKET_BASE_SIZE;
+    if(length > SNTP_PACKET_BASE_SIZE) {
+        if(authCheck(request, length))
+            replyLength += authSign(reply);
+        else {
+            /* A crypto-NAK is a MAC with key ID 0 and no digest. */
+            memset(reply + SNTP_PACKET_BASE_SIZE, 0, AUTH_KEY_ID_SIZE);
+            replyLength += AUTH_KEY_ID_SIZE;
+            stats.numOfNaks++;
+        }
+    }
+
+    if(sendto(udpSocket, reply, replyLength, 0, (const struct sockaddr *)pFrom,
+              sizeof(*pFrom)) == (int)replyLength)
+        stats.numOfReplies++;
+}
+
+void serverPoll(void)
+{
+    if(udpSocket < 0)
+        return;
+
+    for(int i=0; i<SERVER_MAX_READS; i++) {
+        struct timeval tout = {.tv_sec = 0, .tv_usec = 0};
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(udpSocket, &fds);
+        if(select(udpSocket+1, &fds, NULL, NULL, &tout) <= 0)
+            break;
+
+        struct sockaddr_in from;
+        socklen_t fromlen = sizeof(from);
+        int r = recvfrom(udpSocket, request, sizeof(request), 0,
+                         (struct sockaddr *)&from, &fromlen);
+        if(r < 0)
+            break;
+        SntpTimestamp_t rxTime;
+        sntpGetTime(&rxTime);
+        serverReply(r, &from, &rxTime);
+    }
+
+    uint64_t now = timebaseUs();
+    if(now - windowUs >= 1000000) {
+        stats.perSecond = (uint64_t)inWindow * 1000000 / (now - windowUs);
+        if(stats.perSecond > stats.peakPerSecond)
+            stats.peakPerSecond = stats.perSecond;
+        windowUs = now;
+        inWindow = 0;
+        serverUpdateDispersion();
+    }
+}
+
+bool serverRunning(void)
+{
+    return udpSocket >= 0;
+}
+
+void serverStop(void)
+{
+    if(udpSocket >= 0) {
+        closesocket(udpSocket);
+        LogInfo(("Stopped serving after %lu requests.",
+                 (unsigned long)stats.numOfRequests));
+    }
+    udpSocket = -1;
+}
+
+const struct ServerStats * serverStats(void)
+{
+    return &stats;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <fat.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <string.h>
+#include "core_sntp_config.h"
+#include "storage.h"
+
+static bool storageMounted = false;
+
+bool storageInit(void)
+{
+    if(storageMounted)
+        return true;
+    if(!fatInitDefault()) {
+        LogWarn(("No filesystem; settings will not be kept."));
+        return false;
+    }
+
+    /* Create every component of the path, mkdir() only does the last one. */
+    char path[] = NDSNTP_DIR;
+    for(char * p = path + 1; *p != '\0'; p++) {
+        if(*p != '/')
+            continue;
+        *p = '\0';
+        if(mkdir(path, 0777) != 0 && errno != EEXIST) {
+            LogWarn(("Could not create %s. Errno was %i", path, errno));
+            return false;
+        }
+        *p = '/';
+    }
+    storageMounted = true;
+    return true;
+}
+
+bool storageAvailable(void)
+{
+    return storageMounted;
+}
+
+FILE * storageOpen(const char * name, const char * mode)
+{
+    if(!storageMounted)
+        return NULL;
+
+    char path[128];
+    snprintf(path, sizeof(path), "%s%s", NDSNTP_DIR, name);
+    return fopen(path, mode);
+}
@@ -0,0 +1,603 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <nds.h>
+#include <sys/socket.h>
+#include <stdlib.h>
+#include <string.h>
+#include <core_sntp_client.h>
+#include "core_sntp_callbacks.h"
+#include "core_sntp_config.h"
+#include "auth.h"
+#include "broadcast.h"
+#include "dns.h"
+#include "drift.h"
+#include "fanout.h"
+#include "phase.h"
+#include "retry.h"
+#include "timebase.h"
+#include "sync.h"
+
+/* Longest we spin in one step to pin down the clock anchor, see
+ * timebaseRefine(). A bit more than a frame. */
+#define SYNC_REFINE_SPIN_US		20000
+/* Give up on a good anchor after this long and sync with what we have. */
+#define SYNC_REFINE_MAX_US		1100000
+
+struct SyncConfig syncConfig = {
+	.mode = SYNC_FANOUT,
+	.servers = { "us.pool.ntp.org", "time.cloudflare.com" },
+	.numOfServers = 2,
+	.port = SNTP_DEFAULT_SERVER_PORT,
+	.bestOf = 1,
+	.burst = SYNC_DEFAULT_BURST,
+	.broadcastPort = SNTP_DEFAULT_SERVER_PORT,
+	.broadcastDelayMs = -1
+};
+
+/* What a response told us; applied in SYNC_APPLY. */
+struct SyncSample {
+	const SntpServerInfo_t * pServer;
+	SntpTimestamp_t serverTime;
+	int64_t clockOffsetMs;
+	SntpLeapSecondInfo_t leapSecondInfo;
+	int64_t delayMs;		// Round trip less the server's hold time
+};
+
+/* Everything a sync needs that outlives it: the sockets, the coreSNTP context
+ * and its buffer, and the server list. Opened by the first sync and kept until
+ * syncShutdown(), so a re-sync costs one send and one receive.
+ */
+static struct {
+	bool open;
+	SntpServerInfo_t serverInfo[SYNC_MAX_SERVERS];
+	size_t numOfServers;
+	struct Fanout fanout;
+	/* Broadcast mode. Until the delay is known, the fan-out measures it. */
+	struct Broadcast broadcast;
+	int32_t broadcastDelayMs;
+	/* Sequential mode */
+	uint8_t netBuffer[AUTH_PACKET_SIZE];
+	NetworkContext_t netContext;
+	SntpContext_t sntpContext;
+} session = {
+	.fanout = { .udpSocket = -1 },
+	.broadcast = { .netContext = { .udpSocket = -1 } },
+	.broadcastDelayMs = -1,
+	.netContext = { .udpSocket = -1 }
+};
+
+static struct SyncProgress progress = { .state = SYNC_IDLE };
+static struct SyncSample sample;		// The latest response
+static struct SyncSample bestSample;	// Lowest delay of the burst so far
+static int64_t minOffsetMs, maxOffsetMs;
+/* Round trip estimate, kept from one sync to the next. */
+static struct RetryState retry;
+static uint64_t sendUs;		// timebaseUs() of the last request
+static uint64_t resumeUs;	// ...and when to send the next one
+static bool listening;		// SYNC_AWAIT is waiting for a broadcast
+
+static const char * const stateNames[] = {
+	[SYNC_IDLE] = "idle",
+	[SYNC_RESOLVE] = "resolving",
+	[SYNC_SEND] = "sending",
+	[SYNC_AWAIT] = "waiting",
+	[SYNC_BACKOFF] = "backing off",
+	[SYNC_PAUSE] = "sampling",
+	[SYNC_APPLY] = "setting RTC",
+	[SYNC_COMMIT] = "setting RTC",
+	[SYNC_DONE] = "done",
+	[SYNC_FAILED] = "failed",
+	[SYNC_CANCELLED] = "cancelled"
+};
+
+/* Fill in the coreSNTP server list from the configuration. */
+static size_t syncServerInfo(void)
+{
+	size_t n = 0;
+	for(size_t i=0; i<syncConfig.numOfServers && i<SYNC_MAX_SERVERS; i++) {
+		if(syncConfig.servers[i] == NULL) continue;
+		session.serverInfo[n].pServerName = syncConfig.servers[i];
+		session.serverInfo[n].serverNameLen = strlen(syncConfig.servers[i]);
+		session.serverInfo[n].port = syncConfig.port;
+		n++;
+	}
+	return n;
+}
+
+/* Takes the place of sntpSetTime() while coreSNTP processes a response, so
+ * the RTC is written from SYNC_APPLY rather than from inside the receive.
+ */
+static void syncCollect(const SntpServerInfo_t * pTimeServer,
+						const SntpTimestamp_t * pServerTime,
+						int64_t clockOffsetMs,
+						SntpLeapSecondInfo_t leapSecondInfo)
+{
+	sample.pServer = pTimeServer;
+	sample.serverTime = *pServerTime;
+	sample.clockOffsetMs = clockOffsetMs;
+	sample.leapSecondInfo = leapSecondInfo;
+
+	/* Only called here by coreSNTP, with the response still in its buffer.
+	 * The fan-out fills this in itself. */
+	if(syncConfig.mode == SYNC_SEQUENTIAL) {
+		SntpTimestamp_t now;
+		sntpGetTime(&now);
+		sample.delayMs = sntpDelayMs(&session.sntpContext.lastRequestTime,
+									 &now, session.netBuffer);
+	}
+}
+
+/* Add the latest response to the burst. As in the NTP clock filter, the
+ * sample with the lowest delay wins: its offset has the least room for
+ * asymmetric paths to skew it.
+ */
+static void syncKeepSample(void)
+{
+	if(progress.samples == 0 || sample.delayMs < bestSample.delayMs)
+		bestSample = sample;
+	if(progress.samples == 0 || sample.clockOffsetMs < minOffsetMs)
+		minOffsetMs = sample.clockOffsetMs;
+	if(progress.samples == 0 || sample.clockOffsetMs > maxOffsetMs)
+		maxOffsetMs = sample.clockOffsetMs;
+	progress.samples++;
+	progress.offsetMs = bestSample.clockOffsetMs;
+	progress.delayMs = bestSample.delayMs;
+	progress.spreadMs = maxOffsetMs - minOffsetMs;
+}
+
+static void syncFinish(enum SyncState state)
+{
+	progress.state = state;
+	progress.endUs = timebaseUs();
+	if(state == SYNC_DONE)
+		phaseMark(PHASE_SYNC_DONE, 0);
+	else if(state == SYNC_FAILED)
+		phaseMark(PHASE_SYNC_FAILED, 0);
+	if(state == SYNC_FAILED) {
+		LogError(("Failed to request SNTP time.\n"));
+	}
+}
+
+/* Start writing the best sample to the RTC. The offset is applied to the
+ * clock as it is now, since the sample may be a few hundred milliseconds old.
+ */
+static void syncApply(void)
+{
+	progress.sampledUs = timebaseUs();
+	phaseMark(PHASE_SYNC_APPLY, progress.samples);
+	SntpTimestamp_t t = bestSample.serverTime;
+	if(bestSample.clockOffsetMs != SNTP_CLOCK_OFFSET_OVERFLOW) {
+		driftMeasured(-bestSample.clockOffsetMs);
+		sntpGetTime(&t);
+		sntpTimestampAddMs(&t, bestSample.clockOffsetMs);
+	}
+	if(sntpSetTime(bestSample.pServer, &t,
+				   bestSample.clockOffsetMs, bestSample.leapSecondInfo))
+		progress.state = SYNC_COMMIT;
+	else
+		syncFinish(SYNC_FAILED);
+}
+
+/* SYNC_COMMIT: the write lands on the next second edge. */
+static void syncStepCommit(void)
+{
+	enum RtcLinkState state = sntpWriteRtcPoll();
+	if(state != RTCLINK_PENDING)
+		syncFinish(state == RTCLINK_DONE ? SYNC_DONE : SYNC_FAILED);
+}
+
+/* Set up the session: read the server list and, for sequential mode, open
+ * the socket and set up coreSNTP. It moves on to the next server when one
+ * times out. The fan-out opens its own socket on first use.
+ */
+static bool syncOpen(void)
+{
+	session.numOfServers = syncServerInfo();
+	fanoutInit(&session.fanout);
+	if(syncConfig.mode == SYNC_BROADCAST &&
+	   !broadcastOpen(&session.broadcast, syncConfig.broadcastPort))
+		return false;
+	if(syncConfig.mode != SYNC_SEQUENTIAL) {
+		session.open = true;
+		return true;
+	}
+
+	session.netContext.udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	session.netContext.connected = false;
+	if(session.netContext.udpSocket < 0) {
+		LogError(("Could not open UDP socket.\n"));
+		return false;
+	}
+    UdpTransportInterface_t udpTransportIntf = {
+		.pUserContext = &session.netContext,
+		.sendTo = sntpUdpSend,
+		.recvFrom = sntpUdpRecv
+	};
+	
+    SntpStatus_t status = Sntp_Init( &session.sntpContext,
+                                     session.serverInfo,
+                                     session.numOfServers,
+                                     NTP_TIMEOUT,
+                                     session.netBuffer,
+                                     sizeof(session.netBuffer),
+                                     sntpResolveDns,
+                                     sntpGetTime,
+                                     syncCollect,
+                                     &udpTransportIntf,
+                                     authInterface() );
+	if(status != SntpSuccess) {
+		LogError(("Failed to initialize SNTP.\n"));
+		closesocket(session.netContext.udpSocket);
+		session.netContext.udpSocket = -1;
+		return false;
+	}
+	session.open = true;
+	return true;
+}
+
+/* Forget the addresses that did not answer the last fan-out, or told us to go
+ * away, so they are resolved again next time.
+ */
+static void syncDropSilentServers(void)
+{
+	for(size_t i=0; i<session.fanout.numOfServers; i++) {
+		const struct FanoutServer * s = &session.fanout.servers[i];
+		if((s->status == SntpNoResponseReceived && session.fanout.timedOut) ||
+		   s->status == SntpRejectedResponseChangeServer)
+			dnsDropAddress(s->pInfo->pServerName, s->addr);
+	}
+}
+
+/* Feed the round trips of the last request into the timeout estimate. */
+static void syncSampleRtt(void)
+{
+	if(listening) {
+		return;		// Nothing was sent
+	}
+	else if(syncConfig.mode != SYNC_SEQUENTIAL) {
+		for(size_t i=0; i<session.fanout.numOfServers; i++) {
+			if(session.fanout.servers[i].status == SntpSuccess)
+				retrySample(&retry, session.fanout.servers[i].latencyMs);
+		}
+	}
+	else {
+		retrySample(&retry, (timebaseUs() - sendUs) / 1000);
+	}
+}
+
+/* The request failed; wait a little and try again, or give up. `minMs` is the
+ * least we must wait, see retryFailed(). Giving up part way through a burst
+ * still applies the samples we have.
+ */
+static void syncRetry(uint32_t minMs)
+{
+	uint32_t backoffMs = retryFailed(&retry, minMs);
+	if(++progress.attempt < progress.retries) {
+		resumeUs = timebaseUs() + (uint64_t)backoffMs * 1000;
+		progress.state = SYNC_BACKOFF;
+	}
+	else if(progress.samples > 0) {
+		progress.state = SYNC_APPLY;
+	}
+	else {
+		syncFinish(SYNC_FAILED);
+	}
+}
+
+/* Broadcasts are only taken from the first configured server, at the first
+ * address it resolved to. NULL if it didn't resolve. */
+static const struct FanoutServer * syncBroadcastSource(void)
+{
+	for(size_t i=0; i<session.fanout.numOfServers; i++) {
+		if(session.fanout.servers[i].pInfo == &session.serverInfo[0])
+			return &session.fanout.servers[i];
+	}
+	return NULL;
+}
+
+static void syncStepResolve(void)
+{
+	dnsPoll();
+
+	/* A drift correction's RTC write moves the clock; samples taken before it
+	 * lands would be applied to the corrected clock. */
+	if(sntpWriteRtcPoll() == RTCLINK_PENDING)
+		return;
+
+	/* The offsets are only as good as our own clock. */
+	bool anchored = timebaseRefine(SYNC_REFINE_SPIN_US) ||
+		timebaseUs() - progress.startUs > SYNC_REFINE_MAX_US;
+	if(dnsPending() || !anchored)
+		return;
+
+	if(syncConfig.mode != SYNC_SEQUENTIAL) {
+		/* syncStart() asked again for anything expired, dropped or failed,
+		 * and those lookups are over; a name still without an answer is left
+		 * out. Addresses may have changed since the last sync, so start
+		 * over. */
+		fanoutClear(&session.fanout);
+		if(fanoutAddServers(&session.fanout, session.serverInfo,
+							session.numOfServers) == 0) {
+			LogError(("Could not resolve any time server.\n"));
+			syncFinish(SYNC_FAILED);
+			return;
+		}
+		/* Don't listen to, or calibrate against, some other host. */
+		if(syncConfig.mode == SYNC_BROADCAST && syncBroadcastSource() == NULL) {
+			LogError(("Could not resolve %s, the broadcast source.\n",
+					  session.serverInfo[0].pServerName));
+			syncFinish(SYNC_FAILED);
+			return;
+		}
+	}
+	progress.state = SYNC_SEND;
+}
+
+static void syncStepSend(void)
+{
+	SntpStatus_t status;
+	uint32_t timeoutMs = retryTimeoutMs(&retry);
+	if(syncConfig.timeoutMs != 0 && timeoutMs > syncConfig.timeoutMs)
+		timeoutMs = syncConfig.timeoutMs;
+
+	sendUs = timebaseUs();
+	int32_t delayMs = syncConfig.broadcastDelayMs >= 0 ? syncConfig.broadcastDelayMs
+													   : session.broadcastDelayMs;
+	listening = syncConfig.mode == SYNC_BROADCAST && delayMs >= 0;
+	if(listening) {
+		const struct FanoutServer * pSource = syncBroadcastSource();
+		broadcastListen(&session.broadcast, pSource->pInfo, pSource->addr,
+						delayMs, SYNC_BROADCAST_WAIT_MS);
+		status = SntpSuccess;
+	}
+	else if(syncConfig.mode != SYNC_SEQUENTIAL) {
+		status = fanoutStart(&session.fanout, syncConfig.bestOf, timeoutMs);
+	}
+	else {
+		if(session.sntpContext.currentServerIndex >= session.numOfServers)
+			session.sntpContext.currentServerIndex = 0;
+		session.sntpContext.serverResponseTimeoutMs = timeoutMs;
+		sntpUdpDrain(session.netContext.udpSocket);
+		status = Sntp_SendTimeRequest( &session.sntpContext,
+										rand() % UINT32_MAX,
+										NTP_SEND_WAIT_TIME_MS );
+		if(status == SntpErrorDnsFailure) {
+			/* sntpResolveDns() doesn't wait. While the lookup is in flight,
+			 * back off and ask again; if it failed, move on. */
+			const struct DnsQuery * q = dnsLookup(
+				session.serverInfo[session.sntpContext.currentServerIndex].pServerName);
+			if(q == NULL || q->state != DNS_PENDING)
+				session.sntpContext.currentServerIndex++;
+		}
+	}
+
+	if(status == SntpSuccess)
+		progress.state = SYNC_AWAIT;
+	else
+		syncRetry(0);
+}
+
+static void syncStepAwait(void)
+{
+	SntpStatus_t status;
+	uint32_t rateMs = 0;
+
+	if(listening) {
+		status = broadcastPoll(&session.broadcast);
+		if(status == SntpNoResponseReceived)
+			return;
+		if(status == SntpSuccess) {
+			const struct Broadcast * b = &session.broadcast;
+			syncCollect(b->pSource,
+						&b->response.serverTime,
+						b->response.clockOffsetMs,
+						b->response.leapSecondType);
+			sample.delayMs = 2 * b->delayMs;
+		}
+	}
+	else if(syncConfig.mode != SYNC_SEQUENTIAL) {
+		status = fanoutPoll(&session.fanout, 0);
+		if(status == SntpNoResponseReceived)
+			return;
+		syncDropSilentServers();
+		if(status != SntpSuccess && fanoutUsable(&session.fanout) == 0) {
+			LogError(("Every time server turned us away.\n"));
+			syncFinish(SYNC_FAILED);
+			return;
+		}
+		if(session.fanout.rateLimited)
+			rateMs = RETRY_RATE_LIMITED_MS;
+		if(status == SntpSuccess) {
+			const struct FanoutServer * pBest = &session.fanout.servers[session.fanout.best];
+			syncCollect(pBest->pInfo,
+						&pBest->response.serverTime,
+						pBest->response.clockOffsetMs,
+						pBest->response.leapSecondType);
+			sample.delayMs = pBest->delayMs;
+			/* Assume the way here takes as long as the way there. */
+			const struct FanoutServer * pSource = syncBroadcastSource();
+			if(syncConfig.mode == SYNC_BROADCAST && pSource != NULL &&
+			   pSource->status == SntpSuccess) {
+				session.broadcastDelayMs = pSource->delayMs / 2;
+				LogInfo(("Broadcasts from %s take %li ms.",
+						 pSource->pInfo->pServerName,
+						 (long)session.broadcastDelayMs));
+			}
+		}
+	}
+	else {
+		SntpContext_t * pContext = &session.sntpContext;
+		const SntpServerInfo_t * pServer = &session.serverInfo[pContext->currentServerIndex];
+		status = Sntp_ReceiveTimeResponse( pContext, 0 );
+		if(status == SntpNoResponseReceived)
+			return;
+		if(status == SntpErrorNetworkFailure) {
+			/* On the connected socket this is usually the server's port being
+			 * closed. Treat it as a timeout; coreSNTP doesn't move on. */
+			pContext->currentServerIndex++;
+			status = SntpErrorResponseTimeout;
+		}
+		if ( status == SntpErrorResponseTimeout ||
+			 status == SntpRejectedResponseChangeServer ) {
+			/* Don't hand out this address again, see sntpResolveDns(). */
+			dnsDropAddress(pServer->pServerName, pContext->currentServerAddr);
+		}
+		else if(status == SntpServerNotAuthenticated) {
+			LogWarn(("Response from %s failed authentication.",
+					 pServer->pServerName));
+		}
+		else if(status == SntpRejectedResponseRetryWithBackoff) {
+			/* RATE: slow down, and give this server a rest. coreSNTP already
+			 * moves on by itself for the other cases. */
+			rateMs = RETRY_RATE_LIMITED_MS;
+			pContext->currentServerIndex++;
+		}
+		else if(status == SntpSuccess &&
+				sample.leapSecondInfo == AlarmServerNotSynchronized) {
+			/* LI=3: the server's own clock isn't set. Try another. */
+			LogWarn(("%s is not synchronized.", pServer->pServerName));
+			pContext->currentServerIndex++;
+			status = SntpRejectedResponse;
+		}
+	}
+
+	if(status == SntpSuccess) {
+		syncSampleRtt();
+		syncKeepSample();
+		/* Broadcasts come a minute or so apart; one will do. */
+		if(progress.samples < (int)syncConfig.burst &&
+		   syncConfig.mode != SYNC_BROADCAST) {
+			resumeUs = timebaseUs() + SYNC_BURST_SPACING_MS * 1000;
+			progress.state = SYNC_PAUSE;
+		}
+		else {
+			progress.state = SYNC_APPLY;
+		}
+	}
+	else {
+		syncRetry(rateMs);
+	}
+}
+
+/* SYNC_BACKOFF and SYNC_PAUSE */
+static void syncStepWait(void)
+{
+	if(timebaseUs() >= resumeUs)
+		progress.state = SYNC_SEND;
+}
+
+void syncStart(int retries)
+{
+	syncCancel();
+
+	memset(&progress, 0, sizeof(progress));
+	progress.retries = retries;
+	progress.startUs = timebaseUs();
+	progress.state = SYNC_RESOLVE;
+	phaseMark(PHASE_SYNC_START, 0);
+	if(!session.open && !syncOpen()) {
+		syncFinish(SYNC_FAILED);
+		return;
+	}
+	if(session.numOfServers == 0) {
+		LogError(("No time servers configured.\n"));
+		syncFinish(SYNC_FAILED);
+		return;
+	}
+
+	/* Get every lookup going at once. */
+	for(size_t i=0; i<session.numOfServers; i++)
+		dnsResolveAsync(session.serverInfo[i].pServerName);
+}
+
+enum SyncState syncStep(void)
+{
+	enum SyncState last;
+	do {
+		last = progress.state;
+		switch(progress.state) {
+			case SYNC_RESOLVE:
+				syncStepResolve();
+				break;
+			case SYNC_SEND:
+				syncStepSend();
+				break;
+			case SYNC_AWAIT:
+				syncStepAwait();
+				break;
+			case SYNC_BACKOFF:
+			case SYNC_PAUSE:
+				syncStepWait();
+				break;
+			case SYNC_APPLY:
+				syncApply();
+				break;
+			case SYNC_COMMIT:
+				syncStepCommit();
+				break;
+			default:
+				break;
+		}
+	} while(progress.state != last);	// Run on while we make progress
+	return progress.state;
+}
+
+uint32_t syncWaitIrq(void)
+{
+	/* dswifi hands received packets to the ARM9 through the FIFO. */
+	if(progress.state == SYNC_AWAIT || progress.state == SYNC_COMMIT ||
+	   rtclinkLast()->state == RTCLINK_PENDING)
+		return IRQ_VBLANK | IRQ_FIFO_NOT_EMPTY;
+	return IRQ_VBLANK;
+}
+
+void syncCancel(void)
+{
+	/* A write already sent still lands, restarting the RTC's second; the
+	 * next sntpWriteRtcPoll() picks up its answer. */
+	if(progress.state == SYNC_COMMIT)
+		timebaseInvalidate();
+	if(progress.state >= SYNC_RESOLVE && progress.state <= SYNC_COMMIT)
+		syncFinish(SYNC_CANCELLED);
+}
+
+void syncShutdown(void)
+{
+	syncCancel();
+	fanoutClose(&session.fanout);
+	broadcastClose(&session.broadcast);
+	if(session.netContext.udpSocket >= 0)
+		closesocket(session.netContext.udpSocket);
+	session.netContext.udpSocket = -1;
+	session.netContext.connected = false;
+	session.open = false;
+}
+
+const struct SyncProgress * syncProgress(void)
+{
+	return &progress;
+}
+
+const char * syncStateName(enum SyncState state)
+{
+	if(state > SYNC_CANCELLED)
+		return "?";
+	return stateNames[state];
+}
+
+int syncTime(int retries)
+{
+	syncStart(retries);
+	while(syncStep() < SYNC_DONE)
+		cothread_yield_irq(syncWaitIrq());
+	return progress.state == SYNC_DONE ? 0 : -1;
+}
+
+const struct Fanout * syncLastFanout(void)
+{
+	return &session.fanout;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <nds.h>
+#include <time.h>
+#include "timebase.h"
+
+/* The timer counts at BUS_CLOCK/1024, about 32.7 kHz (30.6 us per tick), and
+ * the pair of cascaded timers wraps every 36 hours. The ARM7 second tick comes
+ * from a timer on the same bus clock, so once we know where one second edge
+ * falls on our timer, we know where all of them do.
+ */
+#define TIMEBASE_DIVIDER        1024
+#define TIMEBASE_NO_WINDOW      UINT64_MAX
+
+static uint32_t lastRaw;
+static uint64_t wraps;              /* Wrap-arounds of the 32-bit count, << 32 */
+
+static time_t lastSec;              /* time() at the previous update */
+static uint64_t lastTicks;
+static bool seen = false;
+
+static time_t anchorSec;            /* A second edge: time() became anchorSec */
+static uint64_t anchorTicks;        /* ...at most anchorWindow ticks before this */
+static uint64_t anchorWindow = TIMEBASE_NO_WINDOW;
+
+static uint64_t ticksToUs(uint64_t ticks)
+{
+    /* Split so that nothing overflows however long the console stays on. */
+    uint64_t cycles = ticks * TIMEBASE_DIVIDER;
+    return cycles / BUS_CLOCK * 1000000 + cycles % BUS_CLOCK * 1000000 / BUS_CLOCK;
+}
+
+static uint64_t usToTicks(uint64_t us)
+{
+    return us / 1000000 * BUS_CLOCK / TIMEBASE_DIVIDER +
+           us % 1000000 * BUS_CLOCK / TIMEBASE_DIVIDER / 1000000;
+}
+
+/* 64-bit tick count. */
+static uint64_t timebaseTicks(void)
+{
+    uint16_t hi, lo;
+    do {
+        hi = TIMER_DATA(TIMEBASE_TIMER+1);
+        lo = TIMER_DATA(TIMEBASE_TIMER);
+    } while(hi != TIMER_DATA(TIMEBASE_TIMER+1));
+
+    uint32_t raw = ((uint32_t)hi << 16) | lo;
+    if(raw < lastRaw)
+        wraps += (uint64_t)1 << 32;
+    lastRaw = raw;
+    return wraps | raw;
+}
+
+void timebaseInit(void)
+{
+    TIMER_CR(TIMEBASE_TIMER) = 0;
+    TIMER_CR(TIMEBASE_TIMER+1) = 0;
+    TIMER_DATA(TIMEBASE_TIMER) = 0;
+    TIMER_DATA(TIMEBASE_TIMER+1) = 0;
+    TIMER_CR(TIMEBASE_TIMER+1) = TIMER_ENABLE | TIMER_CASCADE;
+    TIMER_CR(TIMEBASE_TIMER) = TIMER_ENABLE | TIMER_DIV_1024;
+
+    lastRaw = 0;
+    wraps = 0;
+    seen = false;
+    anchorWindow = TIMEBASE_NO_WINDOW;
+}
+
+void timebaseUpdate(void)
+{
+    uint64_t ticks = timebaseTicks();
+    time_t sec = time(NULL);
+
+    if(seen && sec != lastSec) {
+        /* The edge fell somewhere between the last update and this one. Keep
+         * it if that pins it down better than what we have. A jump that the
+         * timer doesn't account for means the clock was set, and the old
+         * anchor is useless; a long one that it does is just a long idle. */
+        uint64_t window = ticks - lastTicks;
+        int64_t skewUs = (int64_t)(sec - lastSec) * 1000000 -
+                         (int64_t)ticksToUs(window);
+        bool set = skewUs < -1000000 || skewUs > 1000000;
+        if(set || window < anchorWindow) {
+            anchorSec = sec;
+            anchorTicks = ticks;
+            anchorWindow = window;
+        }
+    }
+    lastSec = sec;
+    lastTicks = ticks;
+    seen = true;
+}
+
+bool timebaseCalibrate(uint32_t maxMs)
+{
+    uint64_t start = timebaseUs();
+    timebaseUpdate();
+    while(timebaseWindowUs() > TIMEBASE_GOOD_WINDOW_US) {
+        if(timebaseUs() - start >= (uint64_t)maxMs * 1000)
+            return false;
+        timebaseUpdate();
+    }
+    return true;
+}
+
+bool timebaseRefine(uint32_t maxSpinUs)
+{
+    timebaseUpdate();
+    if(timebaseWindowUs() <= TIMEBASE_GOOD_WINDOW_US)
+        return true;
+    if(anchorWindow == TIMEBASE_NO_WINDOW)
+        return false;   // Wait for timebaseUpdate() to see a first edge
+
+    /* Every edge falls in a window that ends a whole number of seconds after
+     * the anchor. Spin from now until just past the end of the next one. */
+    uint64_t sinceAnchorUs = ticksToUs(lastTicks - anchorTicks);
+    uint64_t untilEndUs = 1000000 - sinceAnchorUs % 1000000 + 100;
+    if(untilEndUs > maxSpinUs)
+        return false;
+
+    uint64_t start = timebaseUs();
+    while(timebaseUs() - start <= untilEndUs) {
+        timebaseUpdate();
+        if(timebaseWindowUs() <= TIMEBASE_GOOD_WINDOW_US)
+            return true;
+    }
+    return false;
+}
+
+void timebaseInvalidate(void)
+{
+    anchorWindow = TIMEBASE_NO_WINDOW;
+    seen = false;
+}
+
+void timebaseAnchor(int64_t sec, uint64_t earliestUs, uint64_t latestUs)
+{
+    if(earliestUs > latestUs)
+        earliestUs = latestUs;
+    anchorSec = sec;
+    anchorTicks = usToTicks(latestUs);
+    anchorWindow = anchorTicks - usToTicks(earliestUs);
+    seen = false;
+}
+
+uint32_t timebaseWindowUs(void)
+{
+    if(anchorWindow == TIMEBASE_NO_WINDOW)
+        return UINT32_MAX;
+    return ticksToUs(anchorWindow);
+}
+
+uint64_t timebaseUs(void)
+{
+    return ticksToUs(timebaseTicks());
+}
+
+int64_t timebaseUnixUs(void)
+{
+    timebaseUpdate();
+    if(anchorWindow == TIMEBASE_NO_WINDOW)
+        return (int64_t)time(NULL) * 1000000;
+
+    /* Place the edge in the middle of its window. */
+    uint64_t since = ticksToUs(lastTicks - anchorTicks) + ticksToUs(anchorWindow) / 2;
+    int64_t us = (int64_t)anchorSec * 1000000 + since;
+
+    /* Near an edge the two may be a second apart. More than that means
+     * something moved the clock (e.g. the ARM7 reread the RTC); trust time()
+     * until the next edge. */
+    int64_t diff = us / 1000000 - (int64_t)lastSec;
+    if(diff < -1 || diff > 1) {
+        anchorWindow = TIMEBASE_NO_WINDOW;
+        return (int64_t)lastSec * 1000000;
+    }
+    return us;
+}
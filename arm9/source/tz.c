@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdio.h>
+#include <string.h>
+#include "core_sntp_config.h"
+#include "storage.h"
+#include "tz.h"
+
+#define TZ_MAGIC        0x5a544e44      /* "DNTZ" */
+#define TZ_VERSION      1
+
+struct TzFile
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    int32_t fixedOffset;        /* Used if name is empty */
+    char name[48];
+};
+
+static const struct TzZone * currentZone = NULL;
+static int32_t fixedOffset = 0;
+
+const struct TzZone * tzFind(const char * name)
+{
+    size_t lo = 0, hi = tzNumOfZones;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = strcmp(name, tzZones[mid].name);
+        if(c == 0)
+            return &tzZones[mid];
+        if(c < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return NULL;
+}
+
+const struct TzType * tzTypeAt(const struct TzZone * pZone, int64_t utcSec)
+{
+    int64_t t = utcSec - TZ_EPOCH;
+    if(t < 0 || pZone->numOfTransitions == 0 || t < pZone->times[0])
+        return &pZone->types[0];
+    if(t > UINT32_MAX)
+        t = UINT32_MAX;
+
+    /* Last transition at or before t. */
+    size_t lo = 0, hi = pZone->numOfTransitions;
+    while(hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if(pZone->times[mid] <= (uint32_t)t)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return &pZone->types[pZone->index[lo]];
+}
+
+void tzSetZone(const struct TzZone * pZone)
+{
+    currentZone = pZone;
+}
+
+void tzSetFixed(int32_t utcOffset)
+{
+    currentZone = NULL;
+    fixedOffset = utcOffset;
+}
+
+const struct TzZone * tzCurrentZone(void)
+{
+    return currentZone;
+}
+
+int32_t tzOffsetAt(int64_t utcSec)
+{
+    if(currentZone == NULL)
+        return fixedOffset;
+    return tzTypeAt(currentZone, utcSec)->utcOffset;
+}
+
+bool tzLoad(void)
+{
+    FILE * f = storageOpen(TZ_FILE, "rb");
+    if(f == NULL)
+        return false;
+
+    struct TzFile file;
+    bool ok = fread(&file, sizeof(file), 1, f) == 1 &&
+              file.magic == TZ_MAGIC && file.version == TZ_VERSION;
+    fclose(f);
+    if(!ok) {
+        LogWarn(("Ignoring unreadable timezone file."));
+        return false;
+    }
+
+    file.name[sizeof(file.name) - 1] = '\0';
+    if(file.name[0] == '\0') {
+        tzSetFixed(file.fixedOffset);
+        return true;
+    }
+    const struct TzZone * pZone = tzFind(file.name);
+    if(pZone == NULL) {
+        LogWarn(("Saved timezone %s is not built in.", file.name));
+        return false;
+    }
+    tzSetZone(pZone);
+    return true;
+}
+
+bool tzSave(void)
+{
+    struct TzFile file = {
+        .magic = TZ_MAGIC,
+        .version = TZ_VERSION,
+        .fixedOffset = fixedOffset,
+    };
+    if(currentZone != NULL)
+        strncpy(file.name, currentZone->name, sizeof(file.name) - 1);
+
+    FILE * f = storageOpen(TZ_FILE, "wb");
+    if(f == NULL)
+        return false;
+    bool ok = fwrite(&file, sizeof(file), 1, f) == 1;
+    if(fclose(f) != 0)
+        ok = false;
+    if(!ok)
+        LogWarn(("Could not save the timezone."));
+    return ok;
+}
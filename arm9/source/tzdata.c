@@ -0,0 +1,1682 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+/* Generated by tools/tzgen.py from tzdata 2025b. Do not edit. */
+#include "tz.h"
+
+static const struct TzType types0[] = {
+    {   7200, 0,   0 },   /* EET */
+    {  10800, 1,   4 },   /* EEST */
+};
+static const uint32_t times0[] = {
+      10188000,   23490000,   41637600,   54939600,   73087200,   86389200,
+     104536800,  117838800,  136591200,  149893200,  168040800,  181342800,
+     199490400,  212187600,  230940000,  242427600,  262389600,  273272400,
+     293839200,  304117200,  325893600,  334789200,  337384800,  339195600,
+     453506400,  457131600,  460159200,  464994000,  735948000,  751669200,
+     767397600,  783723600,  798847200,  815173200,  830296800,  846622800,
+     862351200,  878072400,  893800800,  909522000,  925250400,  940971600,
+     956700000,  973026000,  988149600, 1004475600, 1020204000, 1035925200,
+    1051653600, 1067374800, 1083103200, 1098824400, 1114552800, 1130274000,
+    1146002400, 1162328400, 1177452000, 1193778000, 1209506400, 1225227600,
+    1240956000, 1256677200, 1272405600, 1288126800, 1303855200, 1320181200,
+    1335304800, 1351630800, 1366754400, 1383080400, 1398808800, 1414530000,
+    1430258400, 1445979600, 1461708000, 1477429200, 1493157600, 1509483600,
+    1524607200, 1540933200, 1556661600, 1572382800, 1588111200, 1603832400,
+    1619560800, 1635282000, 1651010400, 1667336400, 1682460000, 1698786000,
+    1713909600, 1730235600, 1745964000, 1761685200, 1777413600, 1793134800,
+    1808863200, 1824584400, 1840312800, 1856638800, 1871762400, 1888088400,
+    1903816800, 1919538000, 1935266400, 1950987600, 1966716000, 1982437200,
+    1998165600, 2013886800, 2029615200, 2045941200, 2061064800, 2077390800,
+    2093119200, 2108840400, 2124568800, 2140290000, 2156018400, 2171739600,
+    2187468000, 2203794000, 2218917600, 2235243600, 2250367200, 2266693200,
+    2282421600, 2298142800, 2313871200, 2329592400, 2345320800, 2361042000,
+    2376770400, 2393096400, 2408220000, 2424546000, 2440274400, 2455995600,
+    2471724000, 2487445200, 2503173600, 2518894800, 2534623200, 2550949200,
+    2566072800, 2582398800, 2597522400, 2613848400, 2629576800, 2645298000,
+    2661026400, 2676747600, 2692476000, 2708197200, 2723925600, 2740251600,
+    2755375200, 2771701200, 2787429600, 2803150800, 2818879200, 2834600400,
+    2850328800, 2866050000, 2881778400, 2897499600, 2913228000, 2929554000,
+    2944677600, 2961003600, 2976732000, 2992453200, 3008181600, 3023902800,
+    3039631200, 3055352400, 3071080800, 3087406800, 3102530400, 3118856400,
+    3133980000, 3150306000,
+};
+static const uint8_t index0[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types1[] = {
+    {      0, 0,   9 },   /* +00 */
+    {   3600, 1,  13 },   /* +01 */
+    {   3600, 0,  13 },   /* +01 */
+    {      0, 1,   9 },   /* +00 */
+};
+static const uint32_t times1[] = {
+     265593600,  273538800,  297129600,  304124400,  326073600,  334537200,
+     355104000,  365382000,  388980000,  396064800,  398743200,  402285600,
+     420429600,  426477600,  429415200,  436154400,  449460000,  457236000,
+     460260000,  467604000,  480909600,  487562400,  490586400,  499053600,
+     512359200,  518407200,  521431200,  531108000,  543808800,  548647200,
+     552276000,  562557600,  575258400,  579492000,  582516000,  594007200,
+     610336800,  613360800,  640576800,  644205600,  671421600,  674445600,
+     701661600,  705290400,  732506400,  735530400,  763351200,  766375200,
+     793591200,  797220000,  824436000,  827460000,  855280800,  858304800,
+     885520800,  889149600,  916365600,  919389600,  946605600,  950234400,
+     977450400,  980474400, 1008295200, 1011319200, 1038535200, 1042164000,
+    1069380000, 1072404000, 1099620000, 1103248800, 1130464800, 1134093600,
+    1161309600, 1164333600, 1191549600, 1195178400, 1222394400, 1225418400,
+    1253239200, 1256263200, 1283479200, 1287108000, 1314324000, 1317348000,
+    1344564000, 1348192800, 1375408800, 1379037600, 1406253600, 1409277600,
+    1436493600, 1440122400, 1467338400, 1470362400, 1498183200, 1501207200,
+    1528423200, 1532052000, 1559268000, 1562292000, 1589508000, 1593136800,
+    1620352800, 1623981600, 1651197600, 1654221600, 1681437600, 1685066400,
+    1712282400, 1715306400, 1743127200, 1746151200, 1773367200, 1776996000,
+    1804212000, 1807236000, 1834452000, 1838080800, 1865296800, 1868925600,
+    1896141600, 1899165600, 1926381600, 1930010400, 1957226400, 1960250400,
+    1988071200, 1991095200, 2018311200, 2021940000, 2049156000, 2052180000,
+    2079396000, 2083024800, 2110240800, 2113869600, 2141085600, 2144109600,
+    2171325600, 2174954400, 2202170400, 2205194400, 2233015200, 2236039200,
+    2263255200, 2266884000, 2294100000, 2297124000, 2324340000, 2327968800,
+    2355184800, 2358813600, 2386029600, 2389053600, 2416269600, 2419898400,
+    2447114400, 2450138400, 2477959200, 2480983200, 2508199200, 2511828000,
+    2539044000, 2542068000, 2569284000, 2572912800, 2600128800, 2603152800,
+    2630973600, 2633997600, 2661213600, 2664842400, 2692058400, 2695082400,
+    2722903200, 2725927200, 2753143200, 2756772000,
+};
+static const uint8_t index1[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2,
+    3, 2,
+};
+
+static const struct TzType types2[] = {
+    {   7200, 0,  17 },   /* SAST */
+};
+
+static const struct TzType types3[] = {
+    {   3600, 0,  22 },   /* WAT */
+};
+
+static const struct TzType types4[] = {
+    {  10800, 0,  26 },   /* EAT */
+};
+
+static const struct TzType types5[] = {
+    { -32400, 0,  30 },   /* AKST */
+    { -28800, 1,  35 },   /* AKDT */
+};
+static const uint32_t times5[] = {
+       7988400,   26128800,   39438000,   57578400,   71492400,   89028000,
+     102942000,  120477600,  134391600,  152532000,  165841200,  183981600,
+     197290800,  215431200,  226926000,  247485600,  258375600,  278935200,
+     289825200,  310384800,  321879600,  342439200,  353329200,  373888800,
+     384778800,  405338400,  416228400,  436788000,  447678000,  468237600,
+     479127600,  499687200,  511182000,  531741600,  542631600,  563191200,
+     574081200,  594640800,  605530800,  626090400,  636980400,  657540000,
+     669034800,  689594400,  700484400,  721044000,  731934000,  752493600,
+     763383600,  783943200,  794833200,  815392800,  826282800,  846842400,
+     858337200,  878896800,  889786800,  910346400,  921236400,  941796000,
+     952686000,  973245600,  984135600, 1004695200, 1016190000, 1036749600,
+    1047639600, 1068199200, 1079089200, 1099648800, 1110538800, 1131098400,
+    1141988400, 1162548000, 1173438000, 1193997600, 1205492400, 1226052000,
+    1236942000, 1257501600, 1268391600, 1288951200, 1299841200, 1320400800,
+    1331290800, 1351850400, 1362740400, 1383300000, 1394794800, 1415354400,
+    1426244400, 1446804000, 1457694000, 1478253600, 1489143600, 1509703200,
+    1520593200, 1541152800, 1552647600, 1573207200, 1584097200, 1604656800,
+    1615546800, 1636106400, 1646996400, 1667556000, 1678446000, 1699005600,
+    1709895600, 1730455200, 1741950000, 1762509600, 1773399600, 1793959200,
+    1804849200, 1825408800, 1836298800, 1856858400, 1867748400, 1888308000,
+    1899802800, 1920362400, 1931252400, 1951812000, 1962702000, 1983261600,
+    1994151600, 2014711200, 2025601200, 2046160800, 2057050800, 2077610400,
+    2089105200, 2109664800, 2120554800, 2141114400, 2152004400, 2172564000,
+    2183454000, 2204013600, 2214903600, 2235463200, 2246353200, 2266912800,
+    2278407600, 2298967200, 2309857200, 2330416800, 2341306800, 2361866400,
+    2372756400, 2393316000, 2404206000, 2424765600, 2436260400, 2456820000,
+    2467710000, 2488269600, 2499159600, 2519719200, 2530609200, 2551168800,
+    2562058800, 2582618400, 2593508400, 2614068000, 2625562800, 2646122400,
+    2657012400, 2677572000, 2688462000, 2709021600, 2719911600, 2740471200,
+    2751361200, 2771920800, 2783415600, 2803975200, 2814865200, 2835424800,
+    2846314800, 2866874400, 2877764400, 2898324000, 2909214000, 2929773600,
+    2940663600, 2961223200, 2972718000, 2993277600, 3004167600, 3024727200,
+    3035617200, 3056176800, 3067066800, 3087626400, 3098516400, 3119076000,
+    3129966000, 3150525600,
+};
+static const uint8_t index5[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types6[] = {
+    { -10800, 1,  40 },   /* -03 */
+    { -10800, 0,  40 },   /* -03 */
+    {  -7200, 1,  44 },   /* -02 */
+};
+static const uint32_t times6[] = {
+       5367600,  252298800,  258948000,  277700400,  290397600,
+};
+static const uint8_t index6[] = {
+    1, 2, 1, 2, 1,
+};
+
+static const struct TzType types7[] = {
+    { -18000, 0,  48 },   /* -05 */
+};
+
+static const struct TzType types8[] = {
+    { -14400, 0,  52 },   /* -04 */
+    { -16200, 0,  56 },   /* -0430 */
+};
+static const uint32_t times8[] = {
+     250498800,  515401200,
+};
+static const uint8_t index8[] = {
+    1, 0,
+};
+
+static const struct TzType types9[] = {
+    { -21600, 0,  62 },   /* CST */
+    { -18000, 1,  66 },   /* CDT */
+};
+static const uint32_t times9[] = {
+       7977600,   26118000,   39427200,   57567600,   71481600,   89017200,
+     102931200,  120466800,  134380800,  152521200,  165830400,  183970800,
+     197280000,  215420400,  226915200,  247474800,  258364800,  278924400,
+     289814400,  310374000,  321868800,  342428400,  353318400,  373878000,
+     384768000,  405327600,  416217600,  436777200,  447667200,  468226800,
+     479116800,  499676400,  511171200,  531730800,  542620800,  563180400,
+     574070400,  594630000,  605520000,  626079600,  636969600,  657529200,
+     669024000,  689583600,  700473600,  721033200,  731923200,  752482800,
+     763372800,  783932400,  794822400,  815382000,  826272000,  846831600,
+     858326400,  878886000,  889776000,  910335600,  921225600,  941785200,
+     952675200,  973234800,  984124800, 1004684400, 1016179200, 1036738800,
+    1047628800, 1068188400, 1079078400, 1099638000, 1110528000, 1131087600,
+    1141977600, 1162537200, 1173427200, 1193986800, 1205481600, 1226041200,
+    1236931200, 1257490800, 1268380800, 1288940400, 1299830400, 1320390000,
+    1331280000, 1351839600, 1362729600, 1383289200, 1394784000, 1415343600,
+    1426233600, 1446793200, 1457683200, 1478242800, 1489132800, 1509692400,
+    1520582400, 1541142000, 1552636800, 1573196400, 1584086400, 1604646000,
+    1615536000, 1636095600, 1646985600, 1667545200, 1678435200, 1698994800,
+    1709884800, 1730444400, 1741939200, 1762498800, 1773388800, 1793948400,
+    1804838400, 1825398000, 1836288000, 1856847600, 1867737600, 1888297200,
+    1899792000, 1920351600, 1931241600, 1951801200, 1962691200, 1983250800,
+    1994140800, 2014700400, 2025590400, 2046150000, 2057040000, 2077599600,
+    2089094400, 2109654000, 2120544000, 2141103600, 2151993600, 2172553200,
+    2183443200, 2204002800, 2214892800, 2235452400, 2246342400, 2266902000,
+    2278396800, 2298956400, 2309846400, 2330406000, 2341296000, 2361855600,
+    2372745600, 2393305200, 2404195200, 2424754800, 2436249600, 2456809200,
+    2467699200, 2488258800, 2499148800, 2519708400, 2530598400, 2551158000,
+    2562048000, 2582607600, 2593497600, 2614057200, 2625552000, 2646111600,
+    2657001600, 2677561200, 2688451200, 2709010800, 2719900800, 2740460400,
+    2751350400, 2771910000, 2783404800, 2803964400, 2814854400, 2835414000,
+    2846304000, 2866863600, 2877753600, 2898313200, 2909203200, 2929762800,
+    2940652800, 2961212400, 2972707200, 2993266800, 3004156800, 3024716400,
+    3035606400, 3056166000, 3067056000, 3087615600, 3098505600, 3119065200,
+    3129955200, 3150514800,
+};
+static const uint8_t index9[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types10[] = {
+    { -25200, 0,  70 },   /* MST */
+    { -21600, 1,  74 },   /* MDT */
+};
+static const uint32_t times10[] = {
+       7981200,   26121600,   39430800,   57571200,   71485200,   89020800,
+     102934800,  120470400,  134384400,  152524800,  165834000,  183974400,
+     197283600,  215424000,  226918800,  247478400,  258368400,  278928000,
+     289818000,  310377600,  321872400,  342432000,  353322000,  373881600,
+     384771600,  405331200,  416221200,  436780800,  447670800,  468230400,
+     479120400,  499680000,  511174800,  531734400,  542624400,  563184000,
+     574074000,  594633600,  605523600,  626083200,  636973200,  657532800,
+     669027600,  689587200,  700477200,  721036800,  731926800,  752486400,
+     763376400,  783936000,  794826000,  815385600,  826275600,  846835200,
+     858330000,  878889600,  889779600,  910339200,  921229200,  941788800,
+     952678800,  973238400,  984128400, 1004688000, 1016182800, 1036742400,
+    1047632400, 1068192000, 1079082000, 1099641600, 1110531600, 1131091200,
+    1141981200, 1162540800, 1173430800, 1193990400, 1205485200, 1226044800,
+    1236934800, 1257494400, 1268384400, 1288944000, 1299834000, 1320393600,
+    1331283600, 1351843200, 1362733200, 1383292800, 1394787600, 1415347200,
+    1426237200, 1446796800, 1457686800, 1478246400, 1489136400, 1509696000,
+    1520586000, 1541145600, 1552640400, 1573200000, 1584090000, 1604649600,
+    1615539600, 1636099200, 1646989200, 1667548800, 1678438800, 1698998400,
+    1709888400, 1730448000, 1741942800, 1762502400, 1773392400, 1793952000,
+    1804842000, 1825401600, 1836291600, 1856851200, 1867741200, 1888300800,
+    1899795600, 1920355200, 1931245200, 1951804800, 1962694800, 1983254400,
+    1994144400, 2014704000, 2025594000, 2046153600, 2057043600, 2077603200,
+    2089098000, 2109657600, 2120547600, 2141107200, 2151997200, 2172556800,
+    2183446800, 2204006400, 2214896400, 2235456000, 2246346000, 2266905600,
+    2278400400, 2298960000, 2309850000, 2330409600, 2341299600, 2361859200,
+    2372749200, 2393308800, 2404198800, 2424758400, 2436253200, 2456812800,
+    2467702800, 2488262400, 2499152400, 2519712000, 2530602000, 2551161600,
+    2562051600, 2582611200, 2593501200, 2614060800, 2625555600, 2646115200,
+    2657005200, 2677564800, 2688454800, 2709014400, 2719904400, 2740464000,
+    2751354000, 2771913600, 2783408400, 2803968000, 2814858000, 2835417600,
+    2846307600, 2866867200, 2877757200, 2898316800, 2909206800, 2929766400,
+    2940656400, 2961216000, 2972710800, 2993270400, 3004160400, 3024720000,
+    3035610000, 3056169600, 3067059600, 3087619200, 3098509200, 3119068800,
+    3129958800, 3150518400,
+};
+static const uint8_t index10[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types11[] = {
+    { -14400, 0,  78 },   /* AST */
+    { -10800, 1,  82 },   /* ADT */
+};
+static const uint32_t times11[] = {
+       7970400,   26110800,   39420000,   57560400,   71474400,   89010000,
+     102924000,  120459600,  134373600,  152514000,  165823200,  183963600,
+     197272800,  215413200,  226908000,  247467600,  258357600,  278917200,
+     289807200,  310366800,  321861600,  342421200,  353311200,  373870800,
+     384760800,  405320400,  416210400,  436770000,  447660000,  468219600,
+     479109600,  499669200,  511164000,  531723600,  542613600,  563173200,
+     574063200,  594622800,  605512800,  626072400,  636962400,  657522000,
+     669016800,  689576400,  700466400,  721026000,  731916000,  752475600,
+     763365600,  783925200,  794815200,  815374800,  826264800,  846824400,
+     858319200,  878878800,  889768800,  910328400,  921218400,  941778000,
+     952668000,  973227600,  984117600, 1004677200, 1016172000, 1036731600,
+    1047621600, 1068181200, 1079071200, 1099630800, 1110520800, 1131080400,
+    1141970400, 1162530000, 1173420000, 1193979600, 1205474400, 1226034000,
+    1236924000, 1257483600, 1268373600, 1288933200, 1299823200, 1320382800,
+    1331272800, 1351832400, 1362722400, 1383282000, 1394776800, 1415336400,
+    1426226400, 1446786000, 1457676000, 1478235600, 1489125600, 1509685200,
+    1520575200, 1541134800, 1552629600, 1573189200, 1584079200, 1604638800,
+    1615528800, 1636088400, 1646978400, 1667538000, 1678428000, 1698987600,
+    1709877600, 1730437200, 1741932000, 1762491600, 1773381600, 1793941200,
+    1804831200, 1825390800, 1836280800, 1856840400, 1867730400, 1888290000,
+    1899784800, 1920344400, 1931234400, 1951794000, 1962684000, 1983243600,
+    1994133600, 2014693200, 2025583200, 2046142800, 2057032800, 2077592400,
+    2089087200, 2109646800, 2120536800, 2141096400, 2151986400, 2172546000,
+    2183436000, 2203995600, 2214885600, 2235445200, 2246335200, 2266894800,
+    2278389600, 2298949200, 2309839200, 2330398800, 2341288800, 2361848400,
+    2372738400, 2393298000, 2404188000, 2424747600, 2436242400, 2456802000,
+    2467692000, 2488251600, 2499141600, 2519701200, 2530591200, 2551150800,
+    2562040800, 2582600400, 2593490400, 2614050000, 2625544800, 2646104400,
+    2656994400, 2677554000, 2688444000, 2709003600, 2719893600, 2740453200,
+    2751343200, 2771902800, 2783397600, 2803957200, 2814847200, 2835406800,
+    2846296800, 2866856400, 2877746400, 2898306000, 2909196000, 2929755600,
+    2940645600, 2961205200, 2972700000, 2993259600, 3004149600, 3024709200,
+    3035599200, 3056158800, 3067048800, 3087608400, 3098498400, 3119058000,
+    3129948000, 3150507600,
+};
+static const uint8_t index11[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types12[] = {
+    { -18000, 0,  62 },   /* CST */
+    { -14400, 1,  66 },   /* CDT */
+};
+static const uint32_t times12[] = {
+       7966800,   26110800,   39416400,   57560400,   71470800,   89010000,
+     102920400,  120459600,  133765200,  215413200,  226904400,  246862800,
+     258958800,  278312400,  289803600,  309762000,  321858000,  341816400,
+     353912400,  374475600,  386571600,  405320400,  416206800,  436770000,
+     447656400,  468219600,  479106000,  499669200,  511160400,  531723600,
+     542610000,  563173200,  574059600,  594622800,  605509200,  626072400,
+     636958800,  657522000,  669013200,  689576400,  700462800,  721026000,
+     731912400,  752475600,  763362000,  783925200,  794811600,  815374800,
+     826261200,  846824400,  858315600,  878878800,  889765200,  910328400,
+     921214800,  941778000,  952664400,  973227600,  984114000, 1004677200,
+    1016168400, 1036731600, 1047618000, 1068181200, 1079067600, 1099630800,
+    1110517200, 1131080400, 1141966800, 1162530000, 1173416400, 1193979600,
+    1205470800, 1226034000, 1236920400, 1257483600, 1268370000, 1288933200,
+    1299819600, 1320382800, 1331269200, 1351832400, 1362718800, 1383282000,
+    1394773200, 1415336400, 1426222800, 1446786000, 1457672400, 1478235600,
+    1489122000, 1509685200, 1520571600, 1541134800, 1552626000, 1573189200,
+    1584075600, 1604638800, 1615525200, 1636088400, 1646974800, 1667538000,
+    1678424400, 1698987600, 1709874000, 1730437200, 1741928400, 1762491600,
+    1773378000, 1793941200, 1804827600, 1825390800, 1836277200, 1856840400,
+    1867726800, 1888290000, 1899781200, 1920344400, 1931230800, 1951794000,
+    1962680400, 1983243600, 1994130000, 2014693200, 2025579600, 2046142800,
+    2057029200, 2077592400, 2089083600, 2109646800, 2120533200, 2141096400,
+    2151982800, 2172546000, 2183432400, 2203995600, 2214882000, 2235445200,
+    2246331600, 2266894800, 2278386000, 2298949200, 2309835600, 2330398800,
+    2341285200, 2361848400, 2372734800, 2393298000, 2404184400, 2424747600,
+    2436238800, 2456802000, 2467688400, 2488251600, 2499138000, 2519701200,
+    2530587600, 2551150800, 2562037200, 2582600400, 2593486800, 2614050000,
+    2625541200, 2646104400, 2656990800, 2677554000, 2688440400, 2709003600,
+    2719890000, 2740453200, 2751339600, 2771902800, 2783394000, 2803957200,
+    2814843600, 2835406800, 2846293200, 2866856400, 2877742800, 2898306000,
+    2909192400, 2929755600, 2940642000, 2961205200, 2972696400, 2993259600,
+    3004146000, 3024709200, 3035595600, 3056158800, 3067045200, 3087608400,
+    3098494800, 3119058000, 3129944400, 3150507600,
+};
+static const uint8_t index12[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0,
+};
+
+static const struct TzType types13[] = {
+    { -28800, 0,  86 },   /* PST */
+    { -25200, 1,  90 },   /* PDT */
+};
+static const uint32_t times13[] = {
+       7984800,   26125200,   39434400,   57574800,   71488800,   89024400,
+     102938400,  120474000,  134388000,  152528400,  165837600,  183978000,
+     197287200,  215427600,  226922400,  247482000,  258372000,  278931600,
+     289821600,  310381200,  321876000,  342435600,  353325600,  373885200,
+     384775200,  405334800,  416224800,  436784400,  447674400,  468234000,
+     479124000,  499683600,  511178400,  531738000,  542628000,  563187600,
+     574077600,  594637200,  605527200,  626086800,  636976800,  657536400,
+     669031200,  689590800,  700480800,  721040400,  731930400,  752490000,
+     763380000,  783939600,  794829600,  815389200,  826279200,  846838800,
+     858333600,  878893200,  889783200,  910342800,  921232800,  941792400,
+     952682400,  973242000,  984132000, 1004691600, 1016186400, 1036746000,
+    1047636000, 1068195600, 1079085600, 1099645200, 1110535200, 1131094800,
+    1141984800, 1162544400, 1173434400, 1193994000, 1205488800, 1226048400,
+    1236938400, 1257498000, 1268388000, 1288947600, 1299837600, 1320397200,
+    1331287200, 1351846800, 1362736800, 1383296400, 1394791200, 1415350800,
+    1426240800, 1446800400, 1457690400, 1478250000, 1489140000, 1509699600,
+    1520589600, 1541149200, 1552644000, 1573203600, 1584093600, 1604653200,
+    1615543200, 1636102800, 1646992800, 1667552400, 1678442400, 1699002000,
+    1709892000, 1730451600, 1741946400, 1762506000, 1773396000, 1793955600,
+    1804845600, 1825405200, 1836295200, 1856854800, 1867744800, 1888304400,
+    1899799200, 1920358800, 1931248800, 1951808400, 1962698400, 1983258000,
+    1994148000, 2014707600, 2025597600, 2046157200, 2057047200, 2077606800,
+    2089101600, 2109661200, 2120551200, 2141110800, 2152000800, 2172560400,
+    2183450400, 2204010000, 2214900000, 2235459600, 2246349600, 2266909200,
+    2278404000, 2298963600, 2309853600, 2330413200, 2341303200, 2361862800,
+    2372752800, 2393312400, 2404202400, 2424762000, 2436256800, 2456816400,
+    2467706400, 2488266000, 2499156000, 2519715600, 2530605600, 2551165200,
+    2562055200, 2582614800, 2593504800, 2614064400, 2625559200, 2646118800,
+    2657008800, 2677568400, 2688458400, 2709018000, 2719908000, 2740467600,
+    2751357600, 2771917200, 2783412000, 2803971600, 2814861600, 2835421200,
+    2846311200, 2866870800, 2877760800, 2898320400, 2909210400, 2929770000,
+    2940660000, 2961219600, 2972714400, 2993274000, 3004164000, 3024723600,
+    3035613600, 3056173200, 3067063200, 3087622800, 3098512800, 3119072400,
+    3129962400, 3150522000,
+};
+static const uint8_t index13[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types14[] = {
+    { -21600, 0,  62 },   /* CST */
+    { -18000, 1,  66 },   /* CDT */
+};
+static const uint32_t times14[] = {
+       7977600,   26118000,   42451200,   55148400,   71481600,   89017200,
+     102931200,  120466800,  134380800,  152521200,  165830400,  183970800,
+     197280000,  215420400,  228729600,  246870000,  260784000,  278319600,
+     292233600,  309769200,  323683200,  341823600,  355132800,  373273200,
+     386582400,  404722800,  418636800,  436172400,  450086400,  467622000,
+     481536000,  499071600,  512985600,  531126000,  544435200,  562575600,
+     575884800,  594025200,  607939200,  625474800,  639388800,  656924400,
+     670838400,  688978800,  702288000,  720428400,
+};
+static const uint8_t index14[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types15[] = {
+    { -18000, 0,  94 },   /* EST */
+    { -14400, 1,  98 },   /* EDT */
+};
+static const uint32_t times15[] = {
+       7974000,   26114400,   39423600,   57564000,   71478000,   89013600,
+     102927600,  120463200,  134377200,  152517600,  165826800,  183967200,
+     197276400,  215416800,  226911600,  247471200,  258361200,  278920800,
+     289810800,  310370400,  321865200,  342424800,  353314800,  373874400,
+     384764400,  405324000,  416214000,  436773600,  447663600,  468223200,
+     479113200,  499672800,  511167600,  531727200,  542617200,  563176800,
+     574066800,  594626400,  605516400,  626076000,  636966000,  657525600,
+     669020400,  689580000,  700470000,  721029600,  731919600,  752479200,
+     763369200,  783928800,  794818800,  815378400,  826268400,  846828000,
+     858322800,  878882400,  889772400,  910332000,  921222000,  941781600,
+     952671600,  973231200,  984121200, 1004680800, 1016175600, 1036735200,
+    1047625200, 1068184800, 1079074800, 1099634400, 1110524400, 1131084000,
+    1141974000, 1162533600, 1173423600, 1193983200, 1205478000, 1226037600,
+    1236927600, 1257487200, 1268377200, 1288936800, 1299826800, 1320386400,
+    1331276400, 1351836000, 1362726000, 1383285600, 1394780400, 1415340000,
+    1426230000, 1446789600, 1457679600, 1478239200, 1489129200, 1509688800,
+    1520578800, 1541138400, 1552633200, 1573192800, 1584082800, 1604642400,
+    1615532400, 1636092000, 1646982000, 1667541600, 1678431600, 1698991200,
+    1709881200, 1730440800, 1741935600, 1762495200, 1773385200, 1793944800,
+    1804834800, 1825394400, 1836284400, 1856844000, 1867734000, 1888293600,
+    1899788400, 1920348000, 1931238000, 1951797600, 1962687600, 1983247200,
+    1994137200, 2014696800, 2025586800, 2046146400, 2057036400, 2077596000,
+    2089090800, 2109650400, 2120540400, 2141100000, 2151990000, 2172549600,
+    2183439600, 2203999200, 2214889200, 2235448800, 2246338800, 2266898400,
+    2278393200, 2298952800, 2309842800, 2330402400, 2341292400, 2361852000,
+    2372742000, 2393301600, 2404191600, 2424751200, 2436246000, 2456805600,
+    2467695600, 2488255200, 2499145200, 2519704800, 2530594800, 2551154400,
+    2562044400, 2582604000, 2593494000, 2614053600, 2625548400, 2646108000,
+    2656998000, 2677557600, 2688447600, 2709007200, 2719897200, 2740456800,
+    2751346800, 2771906400, 2783401200, 2803960800, 2814850800, 2835410400,
+    2846300400, 2866860000, 2877750000, 2898309600, 2909199600, 2929759200,
+    2940649200, 2961208800, 2972703600, 2993263200, 3004153200, 3024712800,
+    3035602800, 3056162400, 3067052400, 3087612000, 3098502000, 3119061600,
+    3129951600, 3150511200,
+};
+static const uint8_t index15[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types16[] = {
+    { -25200, 0,  70 },   /* MST */
+};
+
+static const struct TzType types17[] = {
+    { -10800, 1,  40 },   /* -03 */
+    { -14400, 0,  52 },   /* -04 */
+};
+static const uint32_t times17[] = {
+       6145200,   24897600,   37594800,   56347200,   69044400,   87796800,
+     100494000,  119246400,  132548400,  150696000,  163998000,  182145600,
+     195447600,  214200000,  226897200,  245649600,  260161200,  277099200,
+     290401200,  308548800,  323665200,  339998400,  358138800,  367214400,
+     388983600,  399873600,  420433200,  431928000,  451882800,  463377600,
+     516596400,  524462400,  548046000,  555912000,  579495600,  587361600,
+     607921200,  621230400,  639370800,  652680000,  670820400,  684129600,
+     702270000,  716184000,  733719600,  747028800,  765774000,  779083200,
+     797223600,  810532800,  828673200,  841982400,  860122800,  873432000,
+     891572400,  904881600,  923626800,  936331200,  955076400,  968385600,
+     986526000,  999835200, 1017975600, 1031284800, 1049425200, 1062734400,
+    1080874800, 1094184000, 1112929200, 1125633600, 1144378800, 1157688000,
+    1175828400, 1189137600, 1207278000, 1220587200, 1238727600, 1252036800,
+    1270782000, 1283486400, 1302231600, 1315540800, 1333681200, 1346990400,
+    1365130800, 1378440000, 1396580400, 1409889600, 1428030000, 1441339200,
+    1460084400, 1472788800, 1491534000, 1504843200, 1522983600, 1536292800,
+    1554433200, 1567742400, 1585882800, 1599192000, 1617332400, 1630641600,
+    1649386800, 1662696000, 1680836400, 1694145600, 1712286000, 1725595200,
+    1743735600, 1757044800, 1775185200, 1788494400, 1807239600, 1819944000,
+    1838689200, 1851998400, 1870138800, 1883448000, 1901588400, 1914897600,
+    1933038000, 1946347200, 1964487600, 1977796800, 1996542000, 2009246400,
+    2027991600, 2041300800, 2059441200, 2072750400, 2090890800, 2104200000,
+    2122340400, 2135649600, 2154394800, 2167099200, 2185844400, 2199153600,
+    2217294000, 2230603200, 2248743600, 2262052800, 2280193200, 2293502400,
+    2311642800, 2324952000, 2343697200, 2356401600, 2375146800, 2388456000,
+    2406596400, 2419905600, 2438046000, 2451355200, 2469495600, 2482804800,
+    2500945200, 2514254400, 2532999600, 2546308800, 2564449200, 2577758400,
+    2595898800, 2609208000, 2627348400, 2640657600, 2658798000, 2672107200,
+    2690852400, 2703556800, 2722302000, 2735611200, 2753751600, 2767060800,
+    2785201200, 2798510400, 2816650800, 2829960000, 2848100400, 2861409600,
+    2880154800, 2892859200, 2911604400, 2924913600, 2943054000, 2956363200,
+    2974503600, 2987812800, 3005953200, 3019262400, 3038007600, 3050712000,
+    3069457200, 3082766400, 3100906800, 3114216000, 3132356400, 3145665600,
+};
+static const uint8_t index17[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types18[] = {
+    {  -7200, 1,  44 },   /* -02 */
+    { -10800, 0,  40 },   /* -03 */
+};
+static const uint32_t times18[] = {
+       4932000,   24289200,   35776800,   56343600,   67226400,   89607600,
+      98676000,  119847600,  130125600,  152679600,  162180000,  182746800,
+     193629600,  216010800,  225684000,  245646000,  256528800,  277700400,
+     287978400,  309150000,  320032800,  340599600,  351482400,  372049200,
+     383536800,  404103600,  414381600,  435553200,  445831200,  467002800,
+     477885600,  498452400,  509335200,  529902000,  540784800,  561351600,
+     572234400,  594615600,  603684000,
+};
+static const uint8_t index18[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1,
+};
+
+static const struct TzType types19[] = {
+    { -12600, 0, 102 },   /* NST */
+    {  -9000, 1, 106 },   /* NDT */
+};
+static const uint32_t times19[] = {
+       7961460,   26101860,   39411060,   57551460,   71465460,   89001060,
+     102915060,  120450660,  134364660,  152505060,  165814260,  183954660,
+     197263860,  215404260,  226899060,  247458660,  258348660,  278908260,
+     289798260,  310357860,  321852660,  342412260,  353302260,  373869000,
+     384759000,  405318600,  416208600,  436768200,  447658200,  468217800,
+     479107800,  499667400,  511162200,  531721800,  542611800,  563171400,
+     574061400,  594621000,  605511000,  626070600,  636960600,  657520200,
+     669015000,  689574600,  700464600,  721024200,  731914200,  752473800,
+     763363800,  783923400,  794813400,  815373000,  826263000,  846822600,
+     858317400,  878877000,  889767000,  910326600,  921216600,  941776200,
+     952666200,  973225800,  984115800, 1004675400, 1016170200, 1036729800,
+    1047619800, 1068179400, 1079069400, 1099629000, 1110519000, 1131078600,
+    1141968600, 1162528200, 1173418200, 1193977800, 1205472600, 1226032200,
+    1236922200, 1257481800, 1268371800, 1288931400, 1299821400, 1320381000,
+    1331271000, 1351830600, 1362720600, 1383280200, 1394775000, 1415334600,
+    1426224600, 1446784200, 1457674200, 1478233800, 1489123800, 1509683400,
+    1520573400, 1541133000, 1552627800, 1573187400, 1584077400, 1604637000,
+    1615527000, 1636086600, 1646976600, 1667536200, 1678426200, 1698985800,
+    1709875800, 1730435400, 1741930200, 1762489800, 1773379800, 1793939400,
+    1804829400, 1825389000, 1836279000, 1856838600, 1867728600, 1888288200,
+    1899783000, 1920342600, 1931232600, 1951792200, 1962682200, 1983241800,
+    1994131800, 2014691400, 2025581400, 2046141000, 2057031000, 2077590600,
+    2089085400, 2109645000, 2120535000, 2141094600, 2151984600, 2172544200,
+    2183434200, 2203993800, 2214883800, 2235443400, 2246333400, 2266893000,
+    2278387800, 2298947400, 2309837400, 2330397000, 2341287000, 2361846600,
+    2372736600, 2393296200, 2404186200, 2424745800, 2436240600, 2456800200,
+    2467690200, 2488249800, 2499139800, 2519699400, 2530589400, 2551149000,
+    2562039000, 2582598600, 2593488600, 2614048200, 2625543000, 2646102600,
+    2656992600, 2677552200, 2688442200, 2709001800, 2719891800, 2740451400,
+    2751341400, 2771901000, 2783395800, 2803955400, 2814845400, 2835405000,
+    2846295000, 2866854600, 2877744600, 2898304200, 2909194200, 2929753800,
+    2940643800, 2961203400, 2972698200, 2993257800, 3004147800, 3024707400,
+    3035597400, 3056157000, 3067047000, 3087606600, 3098496600, 3119056200,
+    3129946200, 3150505800,
+};
+static const uint8_t index19[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types20[] = {
+    {  10800, 0, 110 },   /* +03 */
+    {  14400, 1, 114 },   /* +04 */
+};
+static const uint32_t times20[] = {
+       7862400,   23673600,   39398400,   55209600,   70934400,   86745600,
+     102470400,  118281600,  134092800,  149904000,  165628800,  181440000,
+     197164800,  212976000,  228700800,  244512000,
+};
+static const uint8_t index20[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types21[] = {
+    {  25200, 0, 118 },   /* +07 */
+};
+
+static const struct TzType types22[] = {
+    {  21600, 0, 122 },   /* +06 */
+    {  25200, 1, 118 },   /* +07 */
+};
+static const uint32_t times22[] = {
+     298746000,  315594000,
+};
+static const uint8_t index22[] = {
+    1, 0,
+};
+
+static const struct TzType types23[] = {
+    {  14400, 0, 114 },   /* +04 */
+};
+
+static const struct TzType types24[] = {
+    {  28800, 0, 126 },   /* HKT */
+};
+
+static const struct TzType types25[] = {
+    {  25200, 0, 130 },   /* WIB */
+};
+
+static const struct TzType types26[] = {
+    {   7200, 0, 134 },   /* IST */
+    {  10800, 1, 138 },   /* IDT */
+};
+static const uint32_t times26[] = {
+       8985600,   24098400,   40086000,   54597600,   70671600,   87256800,
+     102121200,  118447200,  134607600,  149119200,  165628800,  182127600,
+     197078400,  212972400,  228528000,  243212400,  259977600,  276476400,
+     291427200,  307321200,  322876800,  337561200,  354931200,  370825200,
+     386380800,  401670000,  417830400,  436143600,  449280000,  467593200,
+     480729600,  499042800,  512179200,  531097200,  543628800,  562546800,
+     575078400,  593996400,  607132800,  625446000,  638582400,  656895600,
+     670032000,  688950000,  701481600,  720399600,  732931200,  751849200,
+     764985600,  783298800,  796435200,  814748400,  827884800,  846198000,
+     859334400,  878252400,  890784000,  909702000,  922233600,  941151600,
+     954288000,  972601200,  985737600, 1004050800, 1017187200, 1036105200,
+    1048636800, 1067554800, 1080086400, 1099004400, 1111536000, 1130454000,
+    1143590400, 1161903600, 1175040000, 1193353200, 1206489600, 1225407600,
+    1237939200, 1256857200, 1269388800, 1288306800, 1301443200, 1319756400,
+    1332892800, 1351206000, 1364342400, 1382655600, 1395792000, 1414710000,
+    1427241600, 1446159600, 1458691200, 1477609200, 1490745600, 1509058800,
+    1522195200, 1540508400, 1553644800, 1572562800, 1585094400, 1604012400,
+    1616544000, 1635462000, 1648598400, 1666911600, 1680048000, 1698361200,
+    1711497600, 1729810800, 1742947200, 1761865200, 1774396800, 1793314800,
+    1805846400, 1824764400, 1837900800, 1856214000, 1869350400, 1887663600,
+    1900800000, 1919718000, 1932249600, 1951167600, 1963699200, 1982617200,
+    1995148800, 2014066800, 2027203200, 2045516400, 2058652800, 2076966000,
+    2090102400, 2109020400, 2121552000, 2140470000, 2153001600, 2171919600,
+    2185056000, 2203369200, 2216505600, 2234818800, 2247955200, 2266268400,
+    2279404800, 2298322800, 2310854400, 2329772400, 2342304000, 2361222000,
+    2374358400, 2392671600, 2405808000, 2424121200, 2437257600, 2456175600,
+    2468707200, 2487625200, 2500156800, 2519074800, 2532211200, 2550524400,
+    2563660800, 2581974000, 2595110400, 2613423600, 2626560000, 2645478000,
+    2658009600, 2676927600, 2689459200, 2708377200, 2721513600, 2739826800,
+    2752963200, 2771276400, 2784412800, 2803330800, 2815862400, 2834780400,
+    2847312000, 2866230000, 2878761600, 2897679600, 2910816000, 2929129200,
+    2942265600, 2960578800, 2973715200, 2992633200, 3005164800, 3024082800,
+    3036614400, 3055532400, 3068668800, 3086982000, 3100118400, 3118431600,
+    3131568000, 3149881200,
+};
+static const uint8_t index26[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types27[] = {
+    {  16200, 0, 142 },   /* +0430 */
+};
+
+static const struct TzType types28[] = {
+    {  18000, 0, 148 },   /* PKT */
+    {  21600, 1, 152 },   /* PKST */
+};
+static const uint32_t times28[] = {
+      71434800,   87156000,  265575600,  278791200,  293050800,  310327200,
+};
+static const uint8_t index28[] = {
+    1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types29[] = {
+    {  20700, 0, 157 },   /* +0545 */
+};
+
+static const struct TzType types30[] = {
+    {  19800, 0, 134 },   /* IST */
+};
+
+static const struct TzType types31[] = {
+    {  28800, 0,  86 },   /* PST */
+};
+
+static const struct TzType types32[] = {
+    {  32400, 0, 163 },   /* KST */
+};
+
+static const struct TzType types33[] = {
+    {  28800, 0,  62 },   /* CST */
+};
+
+static const struct TzType types34[] = {
+    {  28800, 0, 167 },   /* +08 */
+};
+
+static const struct TzType types35[] = {
+    {  12600, 0, 171 },   /* +0330 */
+    {  16200, 1, 142 },   /* +0430 */
+};
+static const uint32_t times35[] = {
+       6899400,   22793400,   38521800,   54415800,   70057800,   85951800,
+     101593800,  117487800,  133129800,  149023800,  164752200,  180646200,
+     259360200,  275254200,  290982600,  306876600,  322518600,  338412600,
+     354054600,  369948600,  385590600,  401484600,  417213000,  433107000,
+     448749000,  464643000,  480285000,  496179000,  511821000,  527715000,
+     543443400,  559337400,  574979400,  590873400,  606515400,  622409400,
+     638051400,  653945400,  669673800,  685567800,  701209800,  717103800,
+};
+static const uint8_t index35[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types36[] = {
+    {  32400, 0, 177 },   /* JST */
+};
+
+static const struct TzType types37[] = {
+    {  23400, 0, 181 },   /* +0630 */
+};
+
+static const struct TzType types38[] = {
+    {  -3600, 0, 187 },   /* -01 */
+    {      0, 1,   9 },   /* +00 */
+};
+static const uint32_t times38[] = {
+       7347600,   26096400,   38797200,   57546000,   70851600,   88995600,
+     102301200,  120445200,  133750800,  152499600,  165200400,  183949200,
+     196650000,  215398800,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354502800,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449456400,  467600400,
+     480906000,  499050000,  512355600,  531104400,  543805200,  562554000,
+     575254800,  594003600,  607309200,  625453200,  638758800,  656902800,
+     670208400,  688957200,  701658000,  720406800,  733107600,  751856400,
+     765162000,  783306000,  796611600,  814755600,  828061200,  846205200,
+     859510800,  878259600,  890960400,  909709200,  922410000,  941158800,
+     954464400,  972608400,  985914000, 1004058000, 1017363600, 1036112400,
+    1048813200, 1067562000, 1080262800, 1099011600, 1111712400, 1130461200,
+    1143766800, 1161910800, 1175216400, 1193360400, 1206666000, 1225414800,
+    1238115600, 1256864400, 1269565200, 1288314000, 1301619600, 1319763600,
+    1333069200, 1351213200, 1364518800, 1382662800, 1395968400, 1414717200,
+    1427418000, 1446166800, 1458867600, 1477616400, 1490922000, 1509066000,
+    1522371600, 1540515600, 1553821200, 1572570000, 1585270800, 1604019600,
+    1616720400, 1635469200, 1648774800, 1666918800, 1680224400, 1698368400,
+    1711674000, 1729818000, 1743123600, 1761872400, 1774573200, 1793322000,
+    1806022800, 1824771600, 1838077200, 1856221200, 1869526800, 1887670800,
+    1900976400, 1919725200, 1932426000, 1951174800, 1963875600, 1982624400,
+    1995325200, 2014074000, 2027379600, 2045523600, 2058829200, 2076973200,
+    2090278800, 2109027600, 2121728400, 2140477200, 2153178000, 2171926800,
+    2185232400, 2203376400, 2216682000, 2234826000, 2248131600, 2266275600,
+    2279581200, 2298330000, 2311030800, 2329779600, 2342480400, 2361229200,
+    2374534800, 2392678800, 2405984400, 2424128400, 2437434000, 2456182800,
+    2468883600, 2487632400, 2500333200, 2519082000, 2532387600, 2550531600,
+    2563837200, 2581981200, 2595286800, 2613430800, 2626736400, 2645485200,
+    2658186000, 2676934800, 2689635600, 2708384400, 2721690000, 2739834000,
+    2753139600, 2771283600, 2784589200, 2803338000, 2816038800, 2834787600,
+    2847488400, 2866237200, 2878938000, 2897686800, 2910992400, 2929136400,
+    2942442000, 2960586000, 2973891600, 2992640400, 3005341200, 3024090000,
+    3036790800, 3055539600, 3068845200, 3086989200, 3100294800, 3118438800,
+    3131744400, 3149888400,
+};
+static const uint8_t index38[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types39[] = {
+    {      0, 0, 191 },   /* GMT */
+};
+
+static const struct TzType types40[] = {
+    {  37800, 1, 195 },   /* ACDT */
+    {  34200, 0, 200 },   /* ACST */
+};
+static const uint32_t times40[] = {
+       7317000,   26065800,   38766600,   57515400,   70821000,   88965000,
+     102270600,  120414600,  133720200,  152469000,  165169800,  183918600,
+     197224200,  215368200,  228069000,  246817800,  260728200,  276453000,
+     292177800,  307902600,  323627400,  339352200,  355077000,  370801800,
+     386526600,  402856200,  418581000,  434305800,  450030600,  465755400,
+     481480200,  497205000,  512929800,  528654600,  544379400,  560104200,
+     575829000,  592158600,  607883400,  623608200,  639333000,  655057800,
+     670782600,  686507400,  702232200,  717957000,  733681800,  749406600,
+     765736200,  781461000,  797185800,  812910600,  828635400,  844360200,
+     860085000,  875809800,  891534600,  907259400,  922984200,  939313800,
+     955038600,  970763400,  986488200, 1002213000, 1017937800, 1033662600,
+    1049387400, 1065112200, 1080837000, 1096561800, 1112286600, 1128616200,
+    1144341000, 1160065800, 1175790600, 1191515400, 1207240200, 1222965000,
+    1238689800, 1254414600, 1270139400, 1286469000, 1302193800, 1317918600,
+    1333643400, 1349368200, 1365093000, 1380817800, 1396542600, 1412267400,
+    1427992200, 1443717000, 1459441800, 1475771400, 1491496200, 1507221000,
+    1522945800, 1538670600, 1554395400, 1570120200, 1585845000, 1601569800,
+    1617294600, 1633019400, 1649349000, 1665073800, 1680798600, 1696523400,
+    1712248200, 1727973000, 1743697800, 1759422600, 1775147400, 1790872200,
+    1806597000, 1822926600, 1838651400, 1854376200, 1870101000, 1885825800,
+    1901550600, 1917275400, 1933000200, 1948725000, 1964449800, 1980174600,
+    1995899400, 2012229000, 2027953800, 2043678600, 2059403400, 2075128200,
+    2090853000, 2106577800, 2122302600, 2138027400, 2153752200, 2170081800,
+    2185806600, 2201531400, 2217256200, 2232981000, 2248705800, 2264430600,
+    2280155400, 2295880200, 2311605000, 2327329800, 2343054600, 2359384200,
+    2375109000, 2390833800, 2406558600, 2422283400, 2438008200, 2453733000,
+    2469457800, 2485182600, 2500907400, 2516632200, 2532961800, 2548686600,
+    2564411400, 2580136200, 2595861000, 2611585800, 2627310600, 2643035400,
+    2658760200, 2674485000, 2690209800, 2706539400, 2722264200, 2737989000,
+    2753713800, 2769438600, 2785163400, 2800888200, 2816613000, 2832337800,
+    2848062600, 2863787400, 2879512200, 2895841800, 2911566600, 2927291400,
+    2943016200, 2958741000, 2974465800, 2990190600, 3005915400, 3021640200,
+    3037365000, 3053694600, 3069419400, 3085144200, 3100869000, 3116593800,
+    3132318600, 3148043400,
+};
+static const uint8_t index40[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types41[] = {
+    {  36000, 0, 205 },   /* AEST */
+};
+
+static const struct TzType types42[] = {
+    {  34200, 0, 200 },   /* ACST */
+};
+
+static const struct TzType types43[] = {
+    {  28800, 0, 210 },   /* AWST */
+    {  32400, 1, 215 },   /* AWDT */
+};
+static const uint32_t times43[] = {
+     218397600,  228074400,  246823200,  260128800,  278272800,  291578400,
+};
+static const uint8_t index43[] = {
+    1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types44[] = {
+    {  39600, 1, 220 },   /* AEDT */
+    {  36000, 0, 205 },   /* AEST */
+};
+static const uint32_t times44[] = {
+       7315200,   20620800,   38764800,   57513600,   70819200,   88963200,
+     102268800,  120412800,  133718400,  152467200,  165168000,  183916800,
+     197222400,  215366400,  228067200,  246816000,  260726400,  276451200,
+     292176000,  307900800,  323625600,  339350400,  355075200,  370800000,
+     386524800,  402854400,  418579200,  434304000,  450028800,  465753600,
+     481478400,  497203200,  512928000,  528652800,  544377600,  560102400,
+     575827200,  592156800,  607881600,  623606400,  639331200,  655056000,
+     670780800,  686505600,  702230400,  717955200,  733680000,  749404800,
+     765734400,  781459200,  797184000,  812908800,  828633600,  844358400,
+     860083200,  875808000,  891532800,  907257600,  922982400,  939312000,
+     955036800,  970761600,  986486400, 1002211200, 1017936000, 1033660800,
+    1049385600, 1065110400, 1080835200, 1096560000, 1112284800, 1128614400,
+    1144339200, 1160064000, 1175788800, 1191513600, 1207238400, 1222963200,
+    1238688000, 1254412800, 1270137600, 1286467200, 1302192000, 1317916800,
+    1333641600, 1349366400, 1365091200, 1380816000, 1396540800, 1412265600,
+    1427990400, 1443715200, 1459440000, 1475769600, 1491494400, 1507219200,
+    1522944000, 1538668800, 1554393600, 1570118400, 1585843200, 1601568000,
+    1617292800, 1633017600, 1649347200, 1665072000, 1680796800, 1696521600,
+    1712246400, 1727971200, 1743696000, 1759420800, 1775145600, 1790870400,
+    1806595200, 1822924800, 1838649600, 1854374400, 1870099200, 1885824000,
+    1901548800, 1917273600, 1932998400, 1948723200, 1964448000, 1980172800,
+    1995897600, 2012227200, 2027952000, 2043676800, 2059401600, 2075126400,
+    2090851200, 2106576000, 2122300800, 2138025600, 2153750400, 2170080000,
+    2185804800, 2201529600, 2217254400, 2232979200, 2248704000, 2264428800,
+    2280153600, 2295878400, 2311603200, 2327328000, 2343052800, 2359382400,
+    2375107200, 2390832000, 2406556800, 2422281600, 2438006400, 2453731200,
+    2469456000, 2485180800, 2500905600, 2516630400, 2532960000, 2548684800,
+    2564409600, 2580134400, 2595859200, 2611584000, 2627308800, 2643033600,
+    2658758400, 2674483200, 2690208000, 2706537600, 2722262400, 2737987200,
+    2753712000, 2769436800, 2785161600, 2800886400, 2816611200, 2832336000,
+    2848060800, 2863785600, 2879510400, 2895840000, 2911564800, 2927289600,
+    2943014400, 2958739200, 2974464000, 2990188800, 3005913600, 3021638400,
+    3037363200, 3053692800, 3069417600, 3085142400, 3100867200, 3116592000,
+    3132316800, 3148041600,
+};
+static const uint8_t index44[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types45[] = {
+    {   3600, 0, 225 },   /* CET */
+    {   7200, 1, 229 },   /* CEST */
+};
+static const uint32_t times45[] = {
+       7347600,   26096400,   38797200,   57546000,   70851600,   88995600,
+     102301200,  120445200,  133750800,  152499600,  165200400,  183949200,
+     196650000,  215398800,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354502800,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449456400,  467600400,
+     480906000,  499050000,  512355600,  531104400,  543805200,  562554000,
+     575254800,  594003600,  607309200,  625453200,  638758800,  656902800,
+     670208400,  688957200,  701658000,  720406800,  733107600,  751856400,
+     765162000,  783306000,  796611600,  814755600,  828061200,  846205200,
+     859510800,  878259600,  890960400,  909709200,  922410000,  941158800,
+     954464400,  972608400,  985914000, 1004058000, 1017363600, 1036112400,
+    1048813200, 1067562000, 1080262800, 1099011600, 1111712400, 1130461200,
+    1143766800, 1161910800, 1175216400, 1193360400, 1206666000, 1225414800,
+    1238115600, 1256864400, 1269565200, 1288314000, 1301619600, 1319763600,
+    1333069200, 1351213200, 1364518800, 1382662800, 1395968400, 1414717200,
+    1427418000, 1446166800, 1458867600, 1477616400, 1490922000, 1509066000,
+    1522371600, 1540515600, 1553821200, 1572570000, 1585270800, 1604019600,
+    1616720400, 1635469200, 1648774800, 1666918800, 1680224400, 1698368400,
+    1711674000, 1729818000, 1743123600, 1761872400, 1774573200, 1793322000,
+    1806022800, 1824771600, 1838077200, 1856221200, 1869526800, 1887670800,
+    1900976400, 1919725200, 1932426000, 1951174800, 1963875600, 1982624400,
+    1995325200, 2014074000, 2027379600, 2045523600, 2058829200, 2076973200,
+    2090278800, 2109027600, 2121728400, 2140477200, 2153178000, 2171926800,
+    2185232400, 2203376400, 2216682000, 2234826000, 2248131600, 2266275600,
+    2279581200, 2298330000, 2311030800, 2329779600, 2342480400, 2361229200,
+    2374534800, 2392678800, 2405984400, 2424128400, 2437434000, 2456182800,
+    2468883600, 2487632400, 2500333200, 2519082000, 2532387600, 2550531600,
+    2563837200, 2581981200, 2595286800, 2613430800, 2626736400, 2645485200,
+    2658186000, 2676934800, 2689635600, 2708384400, 2721690000, 2739834000,
+    2753139600, 2771283600, 2784589200, 2803338000, 2816038800, 2834787600,
+    2847488400, 2866237200, 2878938000, 2897686800, 2910992400, 2929136400,
+    2942442000, 2960586000, 2973891600, 2992640400, 3005341200, 3024090000,
+    3036790800, 3055539600, 3068845200, 3086989200, 3100294800, 3118438800,
+    3131744400, 3149888400,
+};
+static const uint8_t index45[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types46[] = {
+    {   7200, 0,   0 },   /* EET */
+    {  10800, 1,   4 },   /* EEST */
+};
+static const uint32_t times46[] = {
+       7347600,   26096400,   38797200,   57546000,   70851600,   88995600,
+     102301200,  120445200,  133750800,  152499600,  165200400,  183949200,
+     196650000,  215398800,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354502800,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449456400,  467600400,
+     480906000,  499050000,  512355600,  531104400,  543805200,  562554000,
+     575254800,  594003600,  607309200,  625453200,  638758800,  656902800,
+     670208400,  688957200,  701658000,  720406800,  733107600,  751856400,
+     765162000,  783306000,  796611600,  814755600,  828061200,  846205200,
+     859510800,  878259600,  890960400,  909709200,  922410000,  941158800,
+     954464400,  972608400,  985914000, 1004058000, 1017363600, 1036112400,
+    1048813200, 1067562000, 1080262800, 1099011600, 1111712400, 1130461200,
+    1143766800, 1161910800, 1175216400, 1193360400, 1206666000, 1225414800,
+    1238115600, 1256864400, 1269565200, 1288314000, 1301619600, 1319763600,
+    1333069200, 1351213200, 1364518800, 1382662800, 1395968400, 1414717200,
+    1427418000, 1446166800, 1458867600, 1477616400, 1490922000, 1509066000,
+    1522371600, 1540515600, 1553821200, 1572570000, 1585270800, 1604019600,
+    1616720400, 1635469200, 1648774800, 1666918800, 1680224400, 1698368400,
+    1711674000, 1729818000, 1743123600, 1761872400, 1774573200, 1793322000,
+    1806022800, 1824771600, 1838077200, 1856221200, 1869526800, 1887670800,
+    1900976400, 1919725200, 1932426000, 1951174800, 1963875600, 1982624400,
+    1995325200, 2014074000, 2027379600, 2045523600, 2058829200, 2076973200,
+    2090278800, 2109027600, 2121728400, 2140477200, 2153178000, 2171926800,
+    2185232400, 2203376400, 2216682000, 2234826000, 2248131600, 2266275600,
+    2279581200, 2298330000, 2311030800, 2329779600, 2342480400, 2361229200,
+    2374534800, 2392678800, 2405984400, 2424128400, 2437434000, 2456182800,
+    2468883600, 2487632400, 2500333200, 2519082000, 2532387600, 2550531600,
+    2563837200, 2581981200, 2595286800, 2613430800, 2626736400, 2645485200,
+    2658186000, 2676934800, 2689635600, 2708384400, 2721690000, 2739834000,
+    2753139600, 2771283600, 2784589200, 2803338000, 2816038800, 2834787600,
+    2847488400, 2866237200, 2878938000, 2897686800, 2910992400, 2929136400,
+    2942442000, 2960586000, 2973891600, 2992640400, 3005341200, 3024090000,
+    3036790800, 3055539600, 3068845200, 3086989200, 3100294800, 3118438800,
+    3131744400, 3149888400,
+};
+static const uint8_t index46[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types47[] = {
+    {      0, 1, 191 },   /* GMT */
+    {   3600, 0, 134 },   /* IST */
+};
+static const uint32_t times47[] = {
+       7347600,   26096400,   38797200,   57546000,   70851600,   88995600,
+     102301200,  120445200,  133750800,  152499600,  165200400,  183949200,
+     196650000,  215398800,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354502800,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449456400,  467600400,
+     480906000,  499050000,  512355600,  531104400,  543805200,  562554000,
+     575254800,  594003600,  607309200,  625453200,  638758800,  656902800,
+     670208400,  688957200,  701658000,  720406800,  733107600,  751856400,
+     765162000,  783306000,  796611600,  814755600,  828061200,  846205200,
+     859510800,  878259600,  890960400,  909709200,  922410000,  941158800,
+     954464400,  972608400,  985914000, 1004058000, 1017363600, 1036112400,
+    1048813200, 1067562000, 1080262800, 1099011600, 1111712400, 1130461200,
+    1143766800, 1161910800, 1175216400, 1193360400, 1206666000, 1225414800,
+    1238115600, 1256864400, 1269565200, 1288314000, 1301619600, 1319763600,
+    1333069200, 1351213200, 1364518800, 1382662800, 1395968400, 1414717200,
+    1427418000, 1446166800, 1458867600, 1477616400, 1490922000, 1509066000,
+    1522371600, 1540515600, 1553821200, 1572570000, 1585270800, 1604019600,
+    1616720400, 1635469200, 1648774800, 1666918800, 1680224400, 1698368400,
+    1711674000, 1729818000, 1743123600, 1761872400, 1774573200, 1793322000,
+    1806022800, 1824771600, 1838077200, 1856221200, 1869526800, 1887670800,
+    1900976400, 1919725200, 1932426000, 1951174800, 1963875600, 1982624400,
+    1995325200, 2014074000, 2027379600, 2045523600, 2058829200, 2076973200,
+    2090278800, 2109027600, 2121728400, 2140477200, 2153178000, 2171926800,
+    2185232400, 2203376400, 2216682000, 2234826000, 2248131600, 2266275600,
+    2279581200, 2298330000, 2311030800, 2329779600, 2342480400, 2361229200,
+    2374534800, 2392678800, 2405984400, 2424128400, 2437434000, 2456182800,
+    2468883600, 2487632400, 2500333200, 2519082000, 2532387600, 2550531600,
+    2563837200, 2581981200, 2595286800, 2613430800, 2626736400, 2645485200,
+    2658186000, 2676934800, 2689635600, 2708384400, 2721690000, 2739834000,
+    2753139600, 2771283600, 2784589200, 2803338000, 2816038800, 2834787600,
+    2847488400, 2866237200, 2878938000, 2897686800, 2910992400, 2929136400,
+    2942442000, 2960586000, 2973891600, 2992640400, 3005341200, 3024090000,
+    3036790800, 3055539600, 3068845200, 3086989200, 3100294800, 3118438800,
+    3131744400, 3149888400,
+};
+static const uint8_t index47[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types48[] = {
+    {   7200, 0,   0 },   /* EET */
+    {  10800, 1,   4 },   /* EEST */
+    {  10800, 0, 110 },   /* +03 */
+};
+static const uint32_t times48[] = {
+       7340400,   26089200,   38790000,   57538800,   70844400,   88988400,
+     102294000,  120438000,  133743600,  152492400,  165193200,  183942000,
+     196642800,  215391600,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354589200,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449542800,  467600400,
+     480906000,  500259600,  512355600,  526510800,
+};
+static const uint8_t index48[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 2,
+};
+
+static const struct TzType types49[] = {
+    {      0, 0, 234 },   /* WET */
+    {   3600, 1, 238 },   /* WEST */
+};
+static const uint32_t times49[] = {
+       7347600,   26096400,   38797200,   57546000,   70851600,   88995600,
+     102301200,  120445200,  133750800,  152499600,  165200400,  183949200,
+     196650000,  215398800,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354502800,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449456400,  467600400,
+     480906000,  499050000,  512355600,  531104400,  543805200,  562554000,
+     575254800,  594003600,  607309200,  625453200,  638758800,  656902800,
+     670208400,  688957200,  701658000,  720406800,  733107600,  751856400,
+     765162000,  783306000,  796611600,  814755600,  828061200,  846205200,
+     859510800,  878259600,  890960400,  909709200,  922410000,  941158800,
+     954464400,  972608400,  985914000, 1004058000, 1017363600, 1036112400,
+    1048813200, 1067562000, 1080262800, 1099011600, 1111712400, 1130461200,
+    1143766800, 1161910800, 1175216400, 1193360400, 1206666000, 1225414800,
+    1238115600, 1256864400, 1269565200, 1288314000, 1301619600, 1319763600,
+    1333069200, 1351213200, 1364518800, 1382662800, 1395968400, 1414717200,
+    1427418000, 1446166800, 1458867600, 1477616400, 1490922000, 1509066000,
+    1522371600, 1540515600, 1553821200, 1572570000, 1585270800, 1604019600,
+    1616720400, 1635469200, 1648774800, 1666918800, 1680224400, 1698368400,
+    1711674000, 1729818000, 1743123600, 1761872400, 1774573200, 1793322000,
+    1806022800, 1824771600, 1838077200, 1856221200, 1869526800, 1887670800,
+    1900976400, 1919725200, 1932426000, 1951174800, 1963875600, 1982624400,
+    1995325200, 2014074000, 2027379600, 2045523600, 2058829200, 2076973200,
+    2090278800, 2109027600, 2121728400, 2140477200, 2153178000, 2171926800,
+    2185232400, 2203376400, 2216682000, 2234826000, 2248131600, 2266275600,
+    2279581200, 2298330000, 2311030800, 2329779600, 2342480400, 2361229200,
+    2374534800, 2392678800, 2405984400, 2424128400, 2437434000, 2456182800,
+    2468883600, 2487632400, 2500333200, 2519082000, 2532387600, 2550531600,
+    2563837200, 2581981200, 2595286800, 2613430800, 2626736400, 2645485200,
+    2658186000, 2676934800, 2689635600, 2708384400, 2721690000, 2739834000,
+    2753139600, 2771283600, 2784589200, 2803338000, 2816038800, 2834787600,
+    2847488400, 2866237200, 2878938000, 2897686800, 2910992400, 2929136400,
+    2942442000, 2960586000, 2973891600, 2992640400, 3005341200, 3024090000,
+    3036790800, 3055539600, 3068845200, 3086989200, 3100294800, 3118438800,
+    3131744400, 3149888400,
+};
+static const uint8_t index49[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types50[] = {
+    {      0, 0, 191 },   /* GMT */
+    {   3600, 1, 243 },   /* BST */
+};
+static const uint32_t times50[] = {
+       7347600,   26096400,   38797200,   57546000,   70851600,   88995600,
+     102301200,  120445200,  133750800,  152499600,  165200400,  183949200,
+     196650000,  215398800,  228099600,  246848400,  260154000,  278298000,
+     291603600,  309747600,  323053200,  341802000,  354502800,  373251600,
+     385952400,  404701200,  418006800,  436150800,  449456400,  467600400,
+     480906000,  499050000,  512355600,  531104400,  543805200,  562554000,
+     575254800,  594003600,  607309200,  625453200,  638758800,  656902800,
+     670208400,  688957200,  701658000,  720406800,  733107600,  751856400,
+     765162000,  783306000,  796611600,  814755600,  828061200,  846205200,
+     859510800,  878259600,  890960400,  909709200,  922410000,  941158800,
+     954464400,  972608400,  985914000, 1004058000, 1017363600, 1036112400,
+    1048813200, 1067562000, 1080262800, 1099011600, 1111712400, 1130461200,
+    1143766800, 1161910800, 1175216400, 1193360400, 1206666000, 1225414800,
+    1238115600, 1256864400, 1269565200, 1288314000, 1301619600, 1319763600,
+    1333069200, 1351213200, 1364518800, 1382662800, 1395968400, 1414717200,
+    1427418000, 1446166800, 1458867600, 1477616400, 1490922000, 1509066000,
+    1522371600, 1540515600, 1553821200, 1572570000, 1585270800, 1604019600,
+    1616720400, 1635469200, 1648774800, 1666918800, 1680224400, 1698368400,
+    1711674000, 1729818000, 1743123600, 1761872400, 1774573200, 1793322000,
+    1806022800, 1824771600, 1838077200, 1856221200, 1869526800, 1887670800,
+    1900976400, 1919725200, 1932426000, 1951174800, 1963875600, 1982624400,
+    1995325200, 2014074000, 2027379600, 2045523600, 2058829200, 2076973200,
+    2090278800, 2109027600, 2121728400, 2140477200, 2153178000, 2171926800,
+    2185232400, 2203376400, 2216682000, 2234826000, 2248131600, 2266275600,
+    2279581200, 2298330000, 2311030800, 2329779600, 2342480400, 2361229200,
+    2374534800, 2392678800, 2405984400, 2424128400, 2437434000, 2456182800,
+    2468883600, 2487632400, 2500333200, 2519082000, 2532387600, 2550531600,
+    2563837200, 2581981200, 2595286800, 2613430800, 2626736400, 2645485200,
+    2658186000, 2676934800, 2689635600, 2708384400, 2721690000, 2739834000,
+    2753139600, 2771283600, 2784589200, 2803338000, 2816038800, 2834787600,
+    2847488400, 2866237200, 2878938000, 2897686800, 2910992400, 2929136400,
+    2942442000, 2960586000, 2973891600, 2992640400, 3005341200, 3024090000,
+    3036790800, 3055539600, 3068845200, 3086989200, 3100294800, 3118438800,
+    3131744400, 3149888400,
+};
+static const uint8_t index50[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types51[] = {
+    {  10800, 0, 247 },   /* MSK */
+    {  14400, 1, 251 },   /* MSD */
+    {  14400, 0, 247 },   /* MSK */
+};
+static const uint32_t times51[] = {
+       7340400,   26089200,   38790000,   57538800,   70844400,   88988400,
+     102294000,  120438000,  133743600,  152492400,  165193200,  183942000,
+     196642800,  215391600,  228092400,  246841200,  260146800,  278290800,
+     291596400,  309740400,  323046000,  341794800,  354495600,  467589600,
+};
+static const uint8_t index51[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 2, 0,
+};
+
+static const struct TzType types52[] = {
+    {  46800, 1, 255 },   /* NZDT */
+    {  43200, 0, 260 },   /* NZST */
+};
+static const uint32_t times52[] = {
+       6703200,   23637600,   38152800,   55692000,   69602400,   87141600,
+     101052000,  118591200,  133106400,  150040800,  164556000,  181490400,
+     196005600,  212940000,  227455200,  244389600,  260719200,  275839200,
+     292168800,  307288800,  323618400,  338738400,  355068000,  370188000,
+     386517600,  402242400,  418572000,  433692000,  450021600,  465141600,
+     481471200,  496591200,  512920800,  528040800,  544370400,  559490400,
+     575820000,  591544800,  607874400,  622994400,  639324000,  654444000,
+     670773600,  685893600,  702223200,  717343200,  733672800,  748792800,
+     765727200,  780847200,  797176800,  812296800,  828626400,  843746400,
+     860076000,  875196000,  891525600,  906645600,  922975200,  938700000,
+     955029600,  970149600,  986479200, 1001599200, 1017928800, 1033048800,
+    1049378400, 1064498400, 1080828000, 1095948000, 1112277600, 1128002400,
+    1144332000, 1159452000, 1175781600, 1190901600, 1207231200, 1222351200,
+    1238680800, 1253800800, 1270130400, 1285855200, 1302184800, 1317304800,
+    1333634400, 1348754400, 1365084000, 1380204000, 1396533600, 1411653600,
+    1427983200, 1443103200, 1459432800, 1475157600, 1491487200, 1506607200,
+    1522936800, 1538056800, 1554386400, 1569506400, 1585836000, 1600956000,
+    1617285600, 1632405600, 1649340000, 1664460000, 1680789600, 1695909600,
+    1712239200, 1727359200, 1743688800, 1758808800, 1775138400, 1790258400,
+    1806588000, 1822312800, 1838642400, 1853762400, 1870092000, 1885212000,
+    1901541600, 1916661600, 1932991200, 1948111200, 1964440800, 1979560800,
+    1995890400, 2011615200, 2027944800, 2043064800, 2059394400, 2074514400,
+    2090844000, 2105964000, 2122293600, 2137413600, 2153743200, 2169468000,
+    2185797600, 2200917600, 2217247200, 2232367200, 2248696800, 2263816800,
+    2280146400, 2295266400, 2311596000, 2326716000, 2343045600, 2358770400,
+    2375100000, 2390220000, 2406549600, 2421669600, 2437999200, 2453119200,
+    2469448800, 2484568800, 2500898400, 2516018400, 2532952800, 2548072800,
+    2564402400, 2579522400, 2595852000, 2610972000, 2627301600, 2642421600,
+    2658751200, 2673871200, 2690200800, 2705925600, 2722255200, 2737375200,
+    2753704800, 2768824800, 2785154400, 2800274400, 2816604000, 2831724000,
+    2848053600, 2863173600, 2879503200, 2895228000, 2911557600, 2926677600,
+    2943007200, 2958127200, 2974456800, 2989576800, 3005906400, 3021026400,
+    3037356000, 3053080800, 3069410400, 3084530400, 3100860000, 3115980000,
+    3132309600, 3147429600,
+};
+static const uint8_t index52[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types53[] = {
+    {  49500, 1, 265 },   /* +1345 */
+    {  45900, 0, 271 },   /* +1245 */
+};
+static const uint32_t times53[] = {
+       6703200,   23637600,   38152800,   55692000,   69602400,   87141600,
+     101052000,  118591200,  133106400,  150040800,  164556000,  181490400,
+     196005600,  212940000,  227455200,  244389600,  260719200,  275839200,
+     292168800,  307288800,  323618400,  338738400,  355068000,  370188000,
+     386517600,  402242400,  418572000,  433692000,  450021600,  465141600,
+     481471200,  496591200,  512920800,  528040800,  544370400,  559490400,
+     575820000,  591544800,  607874400,  622994400,  639324000,  654444000,
+     670773600,  685893600,  702223200,  717343200,  733672800,  748792800,
+     765727200,  780847200,  797176800,  812296800,  828626400,  843746400,
+     860076000,  875196000,  891525600,  906645600,  922975200,  938700000,
+     955029600,  970149600,  986479200, 1001599200, 1017928800, 1033048800,
+    1049378400, 1064498400, 1080828000, 1095948000, 1112277600, 1128002400,
+    1144332000, 1159452000, 1175781600, 1190901600, 1207231200, 1222351200,
+    1238680800, 1253800800, 1270130400, 1285855200, 1302184800, 1317304800,
+    1333634400, 1348754400, 1365084000, 1380204000, 1396533600, 1411653600,
+    1427983200, 1443103200, 1459432800, 1475157600, 1491487200, 1506607200,
+    1522936800, 1538056800, 1554386400, 1569506400, 1585836000, 1600956000,
+    1617285600, 1632405600, 1649340000, 1664460000, 1680789600, 1695909600,
+    1712239200, 1727359200, 1743688800, 1758808800, 1775138400, 1790258400,
+    1806588000, 1822312800, 1838642400, 1853762400, 1870092000, 1885212000,
+    1901541600, 1916661600, 1932991200, 1948111200, 1964440800, 1979560800,
+    1995890400, 2011615200, 2027944800, 2043064800, 2059394400, 2074514400,
+    2090844000, 2105964000, 2122293600, 2137413600, 2153743200, 2169468000,
+    2185797600, 2200917600, 2217247200, 2232367200, 2248696800, 2263816800,
+    2280146400, 2295266400, 2311596000, 2326716000, 2343045600, 2358770400,
+    2375100000, 2390220000, 2406549600, 2421669600, 2437999200, 2453119200,
+    2469448800, 2484568800, 2500898400, 2516018400, 2532952800, 2548072800,
+    2564402400, 2579522400, 2595852000, 2610972000, 2627301600, 2642421600,
+    2658751200, 2673871200, 2690200800, 2705925600, 2722255200, 2737375200,
+    2753704800, 2768824800, 2785154400, 2800274400, 2816604000, 2831724000,
+    2848053600, 2863173600, 2879503200, 2895228000, 2911557600, 2926677600,
+    2943007200, 2958127200, 2974456800, 2989576800, 3005906400, 3021026400,
+    3037356000, 3053080800, 3069410400, 3084530400, 3100860000, 3115980000,
+    3132309600, 3147429600,
+};
+static const uint8_t index53[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0,
+};
+
+static const struct TzType types54[] = {
+    {  46800, 1, 277 },   /* +13 */
+    {  43200, 0, 281 },   /* +12 */
+};
+static const uint32_t times54[] = {
+       4888800,  312732000,  323013600,  341157600,  352648800,  372607200,
+     380469600,  404056800,  411919200,  436111200,  443365200,  468165600,
+     474818400,  499615200,  506268000,  531669600,  537717600,  563119200,
+     569167200,  594568800,  600616800,  626623200,  632066400,  661701600,
+     664120800,
+};
+static const uint8_t index54[] = {
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 1, 0, 1,
+};
+
+static const struct TzType types55[] = {
+    {  36000, 0, 285 },   /* GST */
+    {  36000, 0, 289 },   /* ChST */
+};
+static const uint32_t times55[] = {
+      30808800,
+};
+static const uint8_t index55[] = {
+    1,
+};
+
+static const struct TzType types56[] = {
+    { -36000, 0, 294 },   /* HST */
+};
+
+static const struct TzType types57[] = {
+    {  50400, 0, 298 },   /* +14 */
+};
+
+static const struct TzType types58[] = {
+    { -39600, 0, 302 },   /* SST */
+};
+
+static const struct TzType types59[] = {
+    {  50400, 1, 298 },   /* +14 */
+    {  46800, 0, 277 },   /* +13 */
+};
+static const uint32_t times59[] = {
+       6699600,   26658000,   33912000,   58107600,   65361600,  531666000,
+     537714000,
+};
+static const uint8_t index59[] = {
+    1, 0, 1, 0, 1, 0, 1,
+};
+
+static const struct TzType types60[] = {
+    {      0, 0, 306 },   /* UTC */
+};
+
+const char tzAbbrevs[] =
+    "EET\0"
+    "EEST\0"
+    "+00\0"
+    "+01\0"
+    "SAST\0"
+    "WAT\0"
+    "EAT\0"
+    "AKST\0"
+    "AKDT\0"
+    "-03\0"
+    "-02\0"
+    "-05\0"
+    "-04\0"
+    "-0430\0"
+    "CST\0"
+    "CDT\0"
+    "MST\0"
+    "MDT\0"
+    "AST\0"
+    "ADT\0"
+    "PST\0"
+    "PDT\0"
+    "EST\0"
+    "EDT\0"
+    "NST\0"
+    "NDT\0"
+    "+03\0"
+    "+04\0"
+    "+07\0"
+    "+06\0"
+    "HKT\0"
+    "WIB\0"
+    "IST\0"
+    "IDT\0"
+    "+0430\0"
+    "PKT\0"
+    "PKST\0"
+    "+0545\0"
+    "KST\0"
+    "+08\0"
+    "+0330\0"
+    "JST\0"
+    "+0630\0"
+    "-01\0"
+    "GMT\0"
+    "ACDT\0"
+    "ACST\0"
+    "AEST\0"
+    "AWST\0"
+    "AWDT\0"
+    "AEDT\0"
+    "CET\0"
+    "CEST\0"
+    "WET\0"
+    "WEST\0"
+    "BST\0"
+    "MSK\0"
+    "MSD\0"
+    "NZDT\0"
+    "NZST\0"
+    "+1345\0"
+    "+1245\0"
+    "+13\0"
+    "+12\0"
+    "GST\0"
+    "ChST\0"
+    "HST\0"
+    "+14\0"
+    "SST\0"
+    "UTC\0"
+    ;
+
+const struct TzZone tzZones[] = {
+    { "Africa/Cairo", types0, times0, index0, 182 },
+    { "Africa/Casablanca", types1, times1, index1, 178 },
+    { "Africa/Johannesburg", types2, NULL, NULL, 0 },
+    { "Africa/Lagos", types3, NULL, NULL, 0 },
+    { "Africa/Nairobi", types4, NULL, NULL, 0 },
+    { "America/Anchorage", types5, times5, index5, 200 },
+    { "America/Argentina/Buenos_Aires", types6, times6, index6, 5 },
+    { "America/Bogota", types7, NULL, NULL, 0 },
+    { "America/Caracas", types8, times8, index8, 2 },
+    { "America/Chicago", types9, times9, index9, 200 },
+    { "America/Denver", types10, times10, index10, 200 },
+    { "America/Halifax", types11, times11, index11, 200 },
+    { "America/Havana", types12, times12, index12, 196 },
+    { "America/Lima", types7, NULL, NULL, 0 },
+    { "America/Los_Angeles", types13, times13, index13, 200 },
+    { "America/Mexico_City", types14, times14, index14, 46 },
+    { "America/New_York", types15, times15, index15, 200 },
+    { "America/Phoenix", types16, NULL, NULL, 0 },
+    { "America/Santiago", types17, times17, index17, 198 },
+    { "America/Sao_Paulo", types18, times18, index18, 39 },
+    { "America/St_Johns", types19, times19, index19, 200 },
+    { "America/Toronto", types15, times15, index15, 200 },
+    { "America/Vancouver", types13, times13, index13, 200 },
+    { "Asia/Baghdad", types20, times20, index20, 16 },
+    { "Asia/Bangkok", types21, NULL, NULL, 0 },
+    { "Asia/Dhaka", types22, times22, index22, 2 },
+    { "Asia/Dubai", types23, NULL, NULL, 0 },
+    { "Asia/Hong_Kong", types24, NULL, NULL, 0 },
+    { "Asia/Jakarta", types25, NULL, NULL, 0 },
+    { "Asia/Jerusalem", types26, times26, index26, 200 },
+    { "Asia/Kabul", types27, NULL, NULL, 0 },
+    { "Asia/Karachi", types28, times28, index28, 6 },
+    { "Asia/Kathmandu", types29, NULL, NULL, 0 },
+    { "Asia/Kolkata", types30, NULL, NULL, 0 },
+    { "Asia/Manila", types31, NULL, NULL, 0 },
+    { "Asia/Seoul", types32, NULL, NULL, 0 },
+    { "Asia/Shanghai", types33, NULL, NULL, 0 },
+    { "Asia/Singapore", types34, NULL, NULL, 0 },
+    { "Asia/Taipei", types33, NULL, NULL, 0 },
+    { "Asia/Tehran", types35, times35, index35, 42 },
+    { "Asia/Tokyo", types36, NULL, NULL, 0 },
+    { "Asia/Yangon", types37, NULL, NULL, 0 },
+    { "Atlantic/Azores", types38, times38, index38, 200 },
+    { "Atlantic/Reykjavik", types39, NULL, NULL, 0 },
+    { "Australia/Adelaide", types40, times40, index40, 200 },
+    { "Australia/Brisbane", types41, NULL, NULL, 0 },
+    { "Australia/Darwin", types42, NULL, NULL, 0 },
+    { "Australia/Perth", types43, times43, index43, 6 },
+    { "Australia/Sydney", types44, times44, index44, 200 },
+    { "Europe/Amsterdam", types45, times45, index45, 200 },
+    { "Europe/Athens", types46, times46, index46, 200 },
+    { "Europe/Berlin", types45, times45, index45, 200 },
+    { "Europe/Dublin", types47, times47, index47, 200 },
+    { "Europe/Helsinki", types46, times46, index46, 200 },
+    { "Europe/Istanbul", types48, times48, index48, 34 },
+    { "Europe/Lisbon", types49, times49, index49, 200 },
+    { "Europe/London", types50, times50, index50, 200 },
+    { "Europe/Madrid", types45, times45, index45, 200 },
+    { "Europe/Moscow", types51, times51, index51, 24 },
+    { "Europe/Paris", types45, times45, index45, 200 },
+    { "Europe/Rome", types45, times45, index45, 200 },
+    { "Europe/Stockholm", types45, times45, index45, 200 },
+    { "Europe/Warsaw", types45, times45, index45, 200 },
+    { "Pacific/Auckland", types52, times52, index52, 200 },
+    { "Pacific/Chatham", types53, times53, index53, 200 },
+    { "Pacific/Fiji", types54, times54, index54, 25 },
+    { "Pacific/Guam", types55, times55, index55, 1 },
+    { "Pacific/Honolulu", types56, NULL, NULL, 0 },
+    { "Pacific/Kiritimati", types57, NULL, NULL, 0 },
+    { "Pacific/Pago_Pago", types58, NULL, NULL, 0 },
+    { "Pacific/Tongatapu", types59, times59, index59, 7 },
+    { "UTC", types60, NULL, NULL, 0 },
+};
+
+const size_t tzNumOfZones = sizeof(tzZones) / sizeof(tzZones[0]);
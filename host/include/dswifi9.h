@@ -0,0 +1,22 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef DSWIFI9_H
+#define DSWIFI9_H
+
+/* Host stand-in for dswifi. The sockets are the host's own, only the calls that
+ * query the DS wireless state are provided here.
+ */
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* Returns 127.0.0.1 as our address. The DNS servers are the first two
+ * nameservers in /etc/resolv.conf.
+ */
+struct in_addr Wifi_GetIPInfo(struct in_addr *pGateway, struct in_addr *pSnmask,
+                              struct in_addr *pDns1, struct in_addr *pDns2);
+
+#endif  /* ifndef DSWIFI9_H */
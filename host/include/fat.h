@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef FAT_H__
+#define FAT_H__
+
+#include <stdbool.h>
+
+/* The host filesystem is always mounted. NDSNTP_DIR points into the build
+ * directory, see Makefile.host.
+ */
+static inline bool fatInitDefault(void)
+{
+    return true;
+}
+
+#endif  /* ifndef FAT_H__ */
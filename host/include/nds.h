@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_INCLUDE
+#define NDS_INCLUDE
+
+/* Host stand-in for libnds. Only the parts used by the sync engine exist, see
+ * host/source/nds_shim.c for the implementations.
+ */
+#include <nds/ndstypes.h>
+#include <nds/interrupts.h>
+#include <nds/timers.h>
+#include <nds/cothread.h>
+#include <nds/system.h>
+#include <nds/fifocommon.h>
+#include <nds/input.h>
+
+#endif  /* ifndef NDS_INCLUDE */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_COTHREAD_INCLUDE
+#define NDS_COTHREAD_INCLUDE
+
+#include <stdint.h>
+
+/* On the host there is only one thread. Waiting for IRQ_VBLANK sleeps until
+ * the next 60 Hz tick of the monotonic clock, IRQ_FIFO_NOT_EMPTY (packets from
+ * dswifi) wakes up every 250 us, any other interrupt returns immediately.
+ */
+void cothread_yield_irq(uint32_t flag);
+void cothread_yield(void);
+
+#endif  /* ifndef NDS_COTHREAD_INCLUDE */
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_FIFOCOMMON_INCLUDE
+#define NDS_FIFOCOMMON_INCLUDE
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    FIFO_PM         = 0,
+    FIFO_SOUND      = 1,
+    FIFO_SYSTEM     = 2,
+    FIFO_MAXMOD     = 3,
+    FIFO_DSWIFI     = 4,
+    FIFO_STORAGE    = 5,
+    FIFO_FIRMWARE   = 6,
+    FIFO_CAMERA     = 7,
+    FIFO_USER_01    = 8,
+    FIFO_USER_02    = 9,
+    FIFO_USER_03    = 10,
+    FIFO_USER_04    = 11,
+    FIFO_USER_05    = 12,
+    FIFO_USER_06    = 13,
+    FIFO_USER_07    = 14,
+    FIFO_USER_08    = 15,
+} FifoChannels;
+
+#define FIFO_MAX_DATA_BYTES 128
+
+/* There is no ARM7 on the host. The shim answers RTC writes on FIFO_NDSNTP
+ * the way arm7/source/main.c does, and keeps what was written so the host
+ * program can inspect it.
+ */
+bool fifoSendDatamsg(int channel, int num_bytes, void *data_array);
+bool fifoSendValue32(int channel, uint32_t value32);
+bool fifoCheckDatamsg(int channel);
+int fifoCheckDatamsgLength(int channel);
+int fifoGetDatamsg(int channel, int buffersize, uint8_t *destbuffer);
+
+#endif  /* ifndef NDS_FIFOCOMMON_INCLUDE */
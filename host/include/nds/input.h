@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_INPUT_INCLUDE
+#define NDS_INPUT_INCLUDE
+
+/* The host has no keys: none are ever held or pressed. */
+#include <nds/ndstypes.h>
+
+#define KEY_A               (1 << 0)
+#define KEY_B               (1 << 1)
+#define KEY_SELECT          (1 << 2)
+#define KEY_START           (1 << 3)
+#define KEY_RIGHT           (1 << 4)
+#define KEY_LEFT            (1 << 5)
+#define KEY_UP              (1 << 6)
+#define KEY_DOWN            (1 << 7)
+#define KEY_R               (1 << 8)
+#define KEY_L               (1 << 9)
+#define KEY_X               (1 << 10)
+#define KEY_Y               (1 << 11)
+
+vu16 * shimKeyControl(void);
+
+#define REG_KEYCNT          (*shimKeyControl())
+
+void scanKeys(void);
+uint32_t keysHeld(void);
+uint32_t keysDown(void);
+
+#endif  /* ifndef NDS_INPUT_INCLUDE */
@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_INTERRUPTS_INCLUDE
+#define NDS_INTERRUPTS_INCLUDE
+
+/* Same bit positions as the hardware, so masks can be passed around as-is. */
+#define IRQ_VBLANK              (1 << 0)
+#define IRQ_HBLANK              (1 << 1)
+#define IRQ_VCOUNT              (1 << 2)
+#define IRQ_TIMER0              (1 << 3)
+#define IRQ_TIMER1              (1 << 4)
+#define IRQ_TIMER2              (1 << 5)
+#define IRQ_TIMER3              (1 << 6)
+#define IRQ_TIMER(n)            (1 << ((n) + 3))
+#define IRQ_KEYS                (1 << 12)
+#define IRQ_FIFO_NOT_EMPTY      (1 << 18)
+
+/* Nothing to enable on the host; cothread_yield_irq() knows what can wake. */
+void irqEnable(uint32_t irq);
+
+#endif  /* ifndef NDS_INTERRUPTS_INCLUDE */
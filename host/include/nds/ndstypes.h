@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_NDSTYPES_INCLUDE
+#define NDS_NDSTYPES_INCLUDE
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t     u8;
+typedef uint16_t    u16;
+typedef uint32_t    u32;
+typedef uint64_t    u64;
+typedef int8_t      s8;
+typedef int16_t     s16;
+typedef int32_t     s32;
+typedef int64_t     s64;
+
+typedef volatile uint16_t   vu16;
+typedef volatile uint32_t   vu32;
+
+/* There is no ITCM here. */
+#define ITCM_CODE
+
+#endif  /* ifndef NDS_NDSTYPES_INCLUDE */
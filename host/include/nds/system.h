@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_SYSTEM_INCLUDE
+#define NDS_SYSTEM_INCLUDE
+
+#include <stdint.h>
+
+/* Same layout as libnds, the ARM9 sends this struct to the ARM7 as-is. */
+typedef struct rtcTimeAndDate
+{
+    uint8_t year;       // 0 - 99 (2000 - 2099)
+    uint8_t month;      // 1 - 12
+    uint8_t day;        // 1 - 31
+    uint8_t weekday;    // 0 - 6
+    uint8_t hours;      // 0 - 23
+    uint8_t minutes;    // 0 - 59
+    uint8_t seconds;    // 0 - 59
+} rtcTimeAndDate;
+
+typedef struct rtcTime
+{
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t seconds;
+} rtcTime;
+
+#endif  /* ifndef NDS_SYSTEM_INCLUDE */
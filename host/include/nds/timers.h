@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_TIMERS_INCLUDE
+#define NDS_TIMERS_INCLUDE
+
+#include <nds/ndstypes.h>
+
+#define BUS_CLOCK           (33513982)
+
+#define TIMER_ENABLE        (1 << 7)
+#define TIMER_IRQ_REQ       (1 << 6)
+#define TIMER_CASCADE       (1 << 2)
+#define TIMER_DIV_1         (0)
+#define TIMER_DIV_64        (1)
+#define TIMER_DIV_256       (2)
+#define TIMER_DIV_1024      (3)
+
+/* The registers are emulated from the host monotonic clock. Reading
+ * TIMER_DATA() gives the count a real timer would have, including cascades;
+ * writing it has no effect. Overflow interrupts are not emulated.
+ */
+vu16 * shimTimerControl(int timer);
+vu16 * shimTimerData(int timer);
+
+#define TIMER_CR(n)         (*shimTimerControl(n))
+#define TIMER_DATA(n)       (*shimTimerData(n))
+
+typedef enum
+{
+    ClockDivider_1 = 0,
+    ClockDivider_64 = 1,
+    ClockDivider_256 = 2,
+    ClockDivider_1024 = 3
+} ClockDivider;
+
+typedef void (*VoidFn)(void);
+
+/* The callback runs from cothread_yield_irq(), when a wait for the timer's IRQ
+ * outlasts it. */
+void timerStart(int timer, ClockDivider divider, u16 ticks, VoidFn callback);
+u16 timerStop(int timer);
+
+#endif  /* ifndef NDS_TIMERS_INCLUDE */
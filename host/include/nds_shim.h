@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_SHIM_H_
+#define NDS_SHIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <nds/system.h>
+
+/* Inspection hooks for the host build. These do not exist on the DS. */
+
+/* Last date and time the ARM9 sent to the (absent) ARM7. Returns false if the
+ * RTC was never written.
+ */
+bool shimLastRtcWrite(rtcTimeAndDate * pRtc);
+
+/* Number of RTC writes received since startup. */
+uint32_t shimRtcWriteCount(void);
+
+/* Microseconds on the host monotonic clock. */
+uint64_t shimMonotonicUs(void);
+
+#endif  /* ifndef NDS_SHIM_H_ */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDS_SHIM_SYS_SOCKET_H_
+#define NDS_SHIM_SYS_SOCKET_H_
+
+#include_next <sys/socket.h>
+#include <unistd.h>
+
+/* dswifi names it closesocket(), the host calls it close(). */
+static inline int closesocket(int socket)
+{
+    return close(socket);
+}
+
+#endif  /* ifndef NDS_SHIM_SYS_SOCKET_H_ */
@@ -0,0 +1,620 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+
+/* Benchmarks for the sync path, run on the host. Micro-benchmarks report
+ * nanoseconds per call; the numbers only mean something relative to each
+ * other, the DS is far slower. The loopback benchmark runs whole syncs against
+ * a responder on 127.0.0.1 and reports how long they take to get a sample and
+ * to finish. The idle benchmark sits on what the synced screen does between
+ * seconds, the old way (waking every VBlank) and with idleWait(), and reports
+ * wakeups and CPU time per second: the part of the battery drain the ARM9 can
+ * do something about.
+ *
+ * Results go to stdout, one JSON object per line, so they can be kept and
+ * compared between releases. The engine's log is flushed to stderr.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <nds.h>
+#include <core_sntp_client.h>
+#include "core_sntp_callbacks.h"
+#include "core_sntp_config.h"
+#include "auth.h"
+#include "dns.h"
+#include "idle.h"
+#include "log.h"
+#include "ntptime.h"
+#include "sync.h"
+#include "timebase.h"
+#include "tz.h"
+
+#define BENCH_N         1000000
+#define BENCH_RUNS      20
+#define BENCH_IDLE_S    3
+#define BENCH_NTP_SIZE  48
+
+static volatile uint32_t sink;      /* Keeps results from being optimized out */
+static FILE * results;
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void report(const char * name, uint64_t ns, size_t n)
+{
+    fprintf(results, "{\"bench\":\"%s\",\"n\":%zu,\"ns_per_op\":%.1f}\n",
+            name, n, (double)ns / n);
+}
+
+/* Nearest-rank percentile of a sorted array. */
+static uint64_t percentile(const uint64_t * sorted, size_t n, unsigned int p)
+{
+    size_t rank = (n * p + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static int compareU64(const void * a, const void * b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* NTP timestamps spread over 2000-2035, which both paths can convert. */
+static SntpTimestamp_t * makeTimestamps(size_t n)
+{
+    SntpTimestamp_t * t = malloc(n * sizeof(*t));
+    srand(1);
+    for(size_t i=0; i<n; i++) {
+        t[i].seconds = NTPTIME_2000 + (uint32_t)rand() % (36u * 365 * 86400);
+        t[i].fractions = (uint32_t)rand() << 1;
+    }
+    return t;
+}
+
+static void putTimestamp(uint8_t * p, const SntpTimestamp_t * t)
+{
+    uint32_t be[2] = { htonl(t->seconds), htonl(t->fractions) };
+    memcpy(p, be, sizeof(be));
+}
+
+static void realtimeTimestamp(SntpTimestamp_t * t)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ntptimeFromUnixUs((int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000, t);
+}
+
+/* A server response to `pRequest`: LI 0, version 4, mode 4, stratum 2, with
+ * the request's transmit time as the originate time. */
+static void makeResponse(const uint8_t * pRequest, uint8_t * pResponse,
+                         const SntpTimestamp_t * pRx, const SntpTimestamp_t * pTx)
+{
+    memset(pResponse, 0, BENCH_NTP_SIZE);
+    pResponse[0] = 0x24;
+    pResponse[1] = 2;
+    pResponse[2] = 6;
+    pResponse[3] = 0xec;
+    memcpy(pResponse + 12, "LOCL", 4);
+    putTimestamp(pResponse + 16, pRx);
+    memcpy(pResponse + 24, pRequest + 40, 8);
+    putTimestamp(pResponse + 32, pRx);
+    putTimestamp(pResponse + 40, pTx);
+}
+
+/* What sntpSetTime() used to do: coreSNTP's conversion, then libc. */
+static void libcToRtc(const SntpTimestamp_t * pTime, bool local, rtcTimeAndDate * pRtc)
+{
+    uint32_t s, us;
+    Sntp_ConvertToUnixTime(pTime, &s, &us);
+    time_t t = (us<500000)? s : s+1;
+    struct tm ts = local ? *localtime(&t) : *gmtime(&t);
+    pRtc->year = ts.tm_year-100;
+    pRtc->month = ts.tm_mon+1;
+    pRtc->day = ts.tm_mday;
+    pRtc->weekday = ts.tm_wday;
+    pRtc->hours = ts.tm_hour;
+    pRtc->minutes = ts.tm_min;
+    pRtc->seconds = ts.tm_sec;
+}
+
+/* What it does now. */
+static bool ntptimePathToRtc(const SntpTimestamp_t * pTime, bool local, rtcTimeAndDate * pRtc)
+{
+    int64_t us = ntptimeToUnixUs(pTime) + 500000;
+    int64_t s = us / 1000000;
+    if(local)
+        s += tzOffsetAt(s);
+    return ntptimeToRtc(s, pRtc);
+}
+
+static int benchConversion(size_t n)
+{
+    SntpTimestamp_t * t = makeTimestamps(n);
+    rtcTimeAndDate a, b;
+    uint64_t start;
+
+    /* Both must agree before the timings mean anything. */
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    tzSetZone(tzFind("America/New_York"));
+    for(size_t i=0; i<n; i++) {
+        /* coreSNTP's microseconds are a little coarse; near the half second
+         * the two may round differently, and coreSNTP is the one that's off. */
+        int64_t us = ntptimeToUnixUs(&t[i]) % 1000000;
+        if(us > 499990 && us < 500010)
+            continue;
+        for(int local=0; local<2; local++) {
+            libcToRtc(&t[i], local, &a);
+            if(!ntptimePathToRtc(&t[i], local, &b))
+                continue;   // Before 2000 in New York; the RTC can't hold it
+            if(memcmp(&a, &b, sizeof(a)) != 0) {
+                fprintf(stderr, "mismatch at NTP %u.%08x (local %i)\n",
+                        t[i].seconds, t[i].fractions, local);
+                free(t);
+                return 1;
+            }
+        }
+    }
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        libcToRtc(&t[i], false, &a);
+        sink += a.seconds;
+    }
+    report("rtc_convert_libc_utc", nowNs() - start, n);
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        ntptimePathToRtc(&t[i], false, &a);
+        sink += a.seconds;
+    }
+    report("rtc_convert_ntptime_utc", nowNs() - start, n);
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        libcToRtc(&t[i], true, &a);
+        sink += a.seconds;
+    }
+    report("rtc_convert_libc_local", nowNs() - start, n);
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        ntptimePathToRtc(&t[i], true, &a);
+        sink += a.seconds;
+    }
+    report("rtc_convert_ntptime_local", nowNs() - start, n);
+
+    tzSetFixed(0);
+    free(t);
+    return 0;
+}
+
+static void benchTz(size_t n)
+{
+    SntpTimestamp_t * t = makeTimestamps(n);
+    uint64_t start;
+
+    tzSetZone(tzFind("Europe/London"));
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        sink += tzOffsetAt(t[i].seconds - NTPTIME_UNIX_EPOCH);
+    report("tz_offset_at", nowNs() - start, n);
+
+    /* A zone with no transitions, the common case for UTC users. */
+    tzSetZone(tzFind("UTC"));
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        sink += tzOffsetAt(t[i].seconds - NTPTIME_UNIX_EPOCH);
+    report("tz_offset_at_utc", nowNs() - start, n);
+
+    static const char * const names[] = {
+        "America/New_York", "Asia/Tokyo", "Europe/Berlin", "Pacific/Auckland"
+    };
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        sink += tzFind(names[i & 3]) != NULL;
+    report("tz_find", nowNs() - start, n);
+
+    tzSetFixed(0);
+    free(t);
+}
+
+static void benchClock(size_t n)
+{
+    SntpTimestamp_t t;
+    uint64_t start;
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        sntpGetTime(&t);
+        sink += t.fractions;
+    }
+    report("sntp_get_time", nowNs() - start, n);
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        sink += timebaseUs();
+    report("timebase_us", nowNs() - start, n);
+}
+
+/* What a Log macro costs on the network path, and what it costs later. */
+static void benchLog(size_t n)
+{
+    char line[160];
+    uint64_t start;
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        LogInfo(("Server %s answered in %lu us.", "pool.ntp.org",
+                 (unsigned long)i));
+    report("log_write", nowNs() - start, n);
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        sink += logFormat(logGet(i % logCount()), line, sizeof(line));
+    report("log_format", nowNs() - start, n);
+
+    /* Not worth showing. */
+    FILE * null = fopen("/dev/null", "w");
+    if(null != NULL) {
+        logFlush(null);
+        fclose(null);
+    }
+}
+
+static void benchPacket(size_t n)
+{
+    uint8_t request[BENCH_NTP_SIZE], response[BENCH_NTP_SIZE];
+    SntpTimestamp_t txTime, rxTime, requestTime;
+    SntpResponseData_t parsed;
+    uint64_t start;
+
+    realtimeTimestamp(&txTime);
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        requestTime = txTime;
+        Sntp_SerializeRequest(&requestTime, (uint32_t)i, request, sizeof(request));
+        sink += request[47];
+    }
+    report("sntp_serialize_request", nowNs() - start, n);
+
+    /* The request from the last iteration, answered 10 ms later. */
+    rxTime = requestTime;
+    sntpTimestampAddMs(&rxTime, 10);
+    makeResponse(request, response, &requestTime, &requestTime);
+    if(Sntp_DeserializeResponse(&requestTime, &rxTime, response,
+                                sizeof(response), &parsed) != SntpSuccess) {
+        fprintf(stderr, "the test response doesn't parse\n");
+        return;
+    }
+    start = nowNs();
+    for(size_t i=0; i<n; i++) {
+        Sntp_DeserializeResponse(&requestTime, &rxTime, response,
+                                 sizeof(response), &parsed);
+        sink += (uint32_t)parsed.clockOffsetMs;
+    }
+    report("sntp_deserialize_response", nowNs() - start, n);
+
+    start = nowNs();
+    for(size_t i=0; i<n; i++)
+        sink += (uint32_t)sntpDelayMs(&requestTime, &rxTime, response);
+    report("sntp_delay_ms", nowNs() - start, n);
+}
+
+/* Signing a request and checking a response, with each kind of key. The
+ * responder of the sync benchmark doesn't sign, so the key is cleared after. */
+static void benchAuth(size_t n)
+{
+    static const struct {
+        const char * name[2];
+        const char * key;
+    } kinds[] = {
+        { { "auth_sign_md5", "auth_check_md5" }, "1 MD5 0123456789abcdefghij" },
+        { { "auth_sign_sha1", "auth_check_sha1" },
+          "1 SHA1 0123456789abcdef0123456789abcdef01234567" },
+    };
+    uint8_t packet[AUTH_PACKET_SIZE] = { 0x23 };
+    uint64_t start;
+
+    for(size_t k=0; k<sizeof(kinds)/sizeof(kinds[0]); k++) {
+        authParseKey(kinds[k].key);
+        size_t length = 0;
+
+        start = nowNs();
+        for(size_t i=0; i<n; i++) {
+            packet[47] = i;
+            length = SNTP_PACKET_BASE_SIZE + authSign(packet);
+            sink += packet[length - 1];
+        }
+        report(kinds[k].name[0], nowNs() - start, n);
+
+        start = nowNs();
+        for(size_t i=0; i<n; i++)
+            sink += authCheck(packet, length);
+        report(kinds[k].name[1], nowNs() - start, n);
+    }
+    authSetKey(0, AUTH_NONE, NULL, 0);
+}
+
+/* Loopback NTP server for the sync benchmark. */
+static void * responderMain(void * arg)
+{
+    int sock = *(int *)arg;
+    uint8_t request[BENCH_NTP_SIZE], response[BENCH_NTP_SIZE];
+    struct sockaddr_in from;
+    socklen_t fromLength;
+
+    for(;;) {
+        fromLength = sizeof(from);
+        ssize_t r = recvfrom(sock, request, sizeof(request), 0,
+                             (struct sockaddr *)&from, &fromLength);
+        if(r < 0)
+            break;
+        if(r < BENCH_NTP_SIZE)
+            continue;
+        SntpTimestamp_t rx, tx;
+        realtimeTimestamp(&rx);
+        realtimeTimestamp(&tx);
+        makeResponse(request, response, &rx, &tx);
+        sendto(sock, response, sizeof(response), 0,
+               (struct sockaddr *)&from, fromLength);
+    }
+    return NULL;
+}
+
+static uint16_t responderStart(void)
+{
+    static int sock;
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    socklen_t length = sizeof(addr);
+    pthread_t thread;
+
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if(sock < 0 || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+       getsockname(sock, (struct sockaddr *)&addr, &length) != 0 ||
+       pthread_create(&thread, NULL, responderMain, &sock) != 0) {
+        perror("loopback responder");
+        return 0;
+    }
+    pthread_detach(thread);
+    return ntohs(addr.sin_port);
+}
+
+/* Whole syncs against the loopback responder. "Sample" is the time until the
+ * sync has its offset and starts writing the RTC; "total" includes the write,
+ * which waits for the next second edge and so adds up to a second. "Step" is
+ * the longest single syncStep(), which the menus wait on. */
+static void benchSync(enum SyncMode mode, const char * name, int runs)
+{
+    uint64_t * sampleUs = calloc(runs, sizeof(*sampleUs));
+    uint64_t * totalUs = calloc(runs, sizeof(*totalUs));
+    uint64_t stepMaxUs = 0;
+    int failures = 0;
+
+    syncConfig.mode = mode;
+    for(int i=0; i<runs; i++) {
+        const struct SyncProgress * p = syncProgress();
+        syncStart(1);
+        for(;;) {
+            uint64_t t0 = timebaseUs();
+            enum SyncState state = syncStep();
+            if(timebaseUs() - t0 > stepMaxUs)
+                stepMaxUs = timebaseUs() - t0;
+            if(state >= SYNC_DONE)
+                break;
+            cothread_yield_irq(syncWaitIrq());
+        }
+        if(p->state != SYNC_DONE)
+            failures++;
+        sampleUs[i] = p->sampledUs - p->startUs;
+        totalUs[i] = p->endUs - p->startUs;
+        logFlush(stderr);
+    }
+    syncShutdown();
+
+    qsort(sampleUs, runs, sizeof(*sampleUs), compareU64);
+    qsort(totalUs, runs, sizeof(*totalUs), compareU64);
+    fprintf(results, "{\"bench\":\"%s\",\"runs\":%i,\"failures\":%i,"
+            "\"sample_p50_us\":%llu,\"sample_p99_us\":%llu,"
+            "\"total_p50_us\":%llu,\"total_p99_us\":%llu,"
+            "\"total_max_us\":%llu,\"step_max_us\":%llu}\n",
+            name, runs, failures,
+            (unsigned long long)percentile(sampleUs, runs, 50),
+            (unsigned long long)percentile(sampleUs, runs, 99),
+            (unsigned long long)percentile(totalUs, runs, 50),
+            (unsigned long long)percentile(totalUs, runs, 99),
+            (unsigned long long)totalUs[runs - 1],
+            (unsigned long long)stepMaxUs);
+    free(sampleUs);
+    free(totalUs);
+}
+
+static uint64_t cpuUs(void)
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (uint64_t)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000 +
+           ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+}
+
+/* The synced screen with nothing to do for `seconds`. */
+static void benchIdle(const char * name, bool vblank, int seconds)
+{
+    uint64_t start = timebaseUs(), startCpu = cpuUs();
+    uint32_t wakeups = 0;
+
+    idleResetStats();
+    while(timebaseUs() - start < (uint64_t)seconds * 1000000) {
+        if(vblank) {
+            cothread_yield_irq(IRQ_VBLANK);
+            wakeups++;
+        }
+        else {
+            idleWait(0, idleUsToNextSecond());
+            wakeups = idleStats()->wakeups;
+        }
+        sink += time(NULL);
+    }
+
+    double s = (timebaseUs() - start) / 1e6;
+    fprintf(results, "{\"bench\":\"%s\",\"seconds\":%.1f,"
+            "\"wakeups_per_s\":%.1f,\"cpu_us_per_s\":%.0f}\n", name, s,
+            wakeups / s, (cpuUs() - startCpu) / s);
+}
+
+static void usage(const char * name)
+{
+    fprintf(stderr,
+            "usage: %s [-n iterations] [-r runs] [-i seconds] [-m] [-s]\n"
+            "  -n iterations  calls per micro-benchmark (default %i)\n"
+            "  -r runs        syncs per loopback benchmark (default %i)\n"
+            "  -i seconds     length of each idle benchmark, 0 skips them\n"
+            "                 (default %i)\n"
+            "  -m             micro-benchmarks only\n"
+            "  -s             loopback syncs only\n",
+            name, BENCH_N, BENCH_RUNS, BENCH_IDLE_S);
+}
+
+/* The RTC date across the end of 2099, from NTP timestamps in era 1 (the
+ * seconds are NTP's, mod 2^32). The century is dropped, the weekday kept. */
+static int checkCentury(void)
+{
+    static const struct {
+        uint32_t ntpSeconds;
+        rtcTimeAndDate expected;    /* year, month, day, weekday, h, m, s */
+    } cases[] = {
+        { 2016466303u, { 99, 12, 31, 4, 23, 59, 59 } },     /* 2099-12-31 */
+        { 2016466304u, {  0,  1,  1, 5,  0,  0,  0 } },     /* 2100-01-01 */
+        { 2021563904u, {  0,  3,  1, 1,  0,  0,  0 } },     /* 2100-03-01 */
+    };
+
+    for(size_t i=0; i<sizeof(cases)/sizeof(cases[0]); i++) {
+        SntpTimestamp_t t = { cases[i].ntpSeconds, 0 };
+        rtcTimeAndDate r;
+        const rtcTimeAndDate * e = &cases[i].expected;
+        if(!ntptimePathToRtc(&t, false, &r) ||
+           r.year != e->year || r.month != e->month || r.day != e->day ||
+           r.weekday != e->weekday || r.hours != e->hours ||
+           r.minutes != e->minutes || r.seconds != e->seconds) {
+            fprintf(stderr, "NTP %u gave %02u-%02u-%02u %02u:%02u:%02u (weekday %u)\n",
+                    cases[i].ntpSeconds, r.year, r.month, r.day, r.hours,
+                    r.minutes, r.seconds, r.weekday);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* sntpTimestampAddMs() with offsets either way, including the borrow from the
+ * seconds and the wrap into the previous era. */
+static int checkTimestampAdd(void)
+{
+    static const struct {
+        SntpTimestamp_t t;
+        int64_t ms;
+        SntpTimestamp_t expected;
+    } cases[] = {
+        { { 100, 0x10000000 },   250, { 100, 0x50000000 } },
+        { { 100, 0x10000000 },  -250, {  99, 0xd0000000 } },
+        { { 100, 0x80000000 }, -1500, {  99, 0x00000000 } },
+        { { 100, 0xc0000000 },   500, { 101, 0x40000000 } },
+        { { 100, 0x00000000 }, -2000, {  98, 0x00000000 } },
+        { {   0, 0x00000100 },  -250, { 0xffffffff, 0xc0000100 } },
+    };
+
+    for(size_t i=0; i<sizeof(cases)/sizeof(cases[0]); i++) {
+        SntpTimestamp_t t = cases[i].t;
+        sntpTimestampAddMs(&t, cases[i].ms);
+        if(t.seconds != cases[i].expected.seconds ||
+           t.fractions != cases[i].expected.fractions) {
+            fprintf(stderr, "%u.%08x %+lli ms gave %u.%08x, not %u.%08x\n",
+                    cases[i].t.seconds, cases[i].t.fractions,
+                    (long long)cases[i].ms, t.seconds, t.fractions,
+                    cases[i].expected.seconds, cases[i].expected.fractions);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = BENCH_N;
+    int runs = BENCH_RUNS, idleS = BENCH_IDLE_S, opt;
+    bool micro = true, sync = true;
+
+    while((opt = getopt(argc, argv, "n:r:i:msh")) != -1) {
+        switch(opt) {
+            case 'n': n = strtoul(optarg, NULL, 10); break;
+            case 'r': runs = atoi(optarg); break;
+            case 'i': idleS = atoi(optarg); break;
+            case 'm': sync = false; idleS = 0; break;
+            case 's': micro = false; idleS = 0; break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if(n < 1) n = 1;
+    if(runs < 1) runs = 1;
+
+    /* Keep stdout for the results; the engine logs with printf. */
+    results = fdopen(dup(STDOUT_FILENO), "w");
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    if(results == NULL)
+        return 1;
+
+    timebaseInit();
+
+    if(micro) {
+        if(checkTimestampAdd() != 0 || checkCentury() != 0 ||
+           benchConversion(n) != 0)
+            return 1;
+        benchTz(n);
+        benchClock(n);
+        benchLog(n);
+        benchPacket(n);
+        benchAuth(n);
+    }
+
+    if(sync) {
+        uint16_t port = responderStart();
+        if(port == 0 || !dnsInit())
+            return 1;
+        syncConfig.servers[0] = "127.0.0.1";
+        syncConfig.numOfServers = 1;
+        syncConfig.port = port;
+        syncConfig.burst = 1;
+        benchSync(SYNC_FANOUT, "sync_loopback_fanout", runs);
+        benchSync(SYNC_SEQUENTIAL, "sync_loopback_sequential", runs);
+        dnsClose();
+    }
+
+    if(idleS > 0) {
+        idleInit();
+        timebaseCalibrate(2000);
+        benchIdle("idle_synced_vblank", true, idleS);
+        benchIdle("idle_synced_idlewait", false, idleS);
+    }
+
+    fclose(results);
+    return 0;
+}
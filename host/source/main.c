@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+
+/* Host driver for the sync engine. Runs syncTime() against a server (normally
+ * a local one) a number of times and prints how long each run took, so the
+ * sync path can be profiled with the usual Linux tools. With -S it then
+ * serves time, as a synced console would, until interrupted.
+ */
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <nds.h>
+#include <dswifi9.h>
+#include "nds_shim.h"
+#include "addrcache.h"
+#include "auth.h"
+#include "dns.h"
+#include "drift.h"
+#include "log.h"
+#include "phase.h"
+#include "rtclink.h"
+#include "server.h"
+#include "storage.h"
+#include "sync.h"
+#include "timebase.h"
+#include "tz.h"
+
+static volatile sig_atomic_t stop;
+
+static void onSignal(int sig)
+{
+    stop = 1;
+}
+
+/* Serves time on `port` until SIGINT, printing the request rate every second. */
+static void serve(uint16_t port)
+{
+    const struct Fanout * f = syncLastFanout();
+    uint32_t refId = f->best != FANOUT_NONE ? f->servers[f->best].addr : 0;
+    if(!serverStart(port, refId, syncProgress()->delayMs)) {
+        logFlush(stdout);
+        return;
+    }
+    struct sigaction sa = { .sa_handler = onSignal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    uint64_t nextUs = shimMonotonicUs() + 1000000;
+    const struct ServerStats * s = serverStats();
+    while(!stop) {
+        serverPoll();
+        cothread_yield_irq(IRQ_FIFO_NOT_EMPTY);
+        timebaseUpdate();
+        if(shimMonotonicUs() >= nextUs) {
+            nextUs += 1000000;
+            printf("serve  : %lu req/s\n", (unsigned long)s->perSecond);
+            fflush(stdout);
+        }
+    }
+    printf("serve  : %lu requests, %lu replies, %lu ignored, %lu naks, "
+           "peak %lu req/s\n",
+           (unsigned long)s->numOfRequests, (unsigned long)s->numOfReplies,
+           (unsigned long)s->numOfIgnored, (unsigned long)s->numOfNaks,
+           (unsigned long)s->peakPerSecond);
+    serverStop();
+    logFlush(stdout);
+}
+
+static int compareUs(const void * a, const void * b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(const char * name)
+{
+    fprintf(stderr,
+            "usage: %s [-p port] [-n runs] [-r retries] [-s] [-b best] [-k samples]\n"
+            "       [-z zone] [-a key] [-B port] [-D delay] [-S port] [server...]\n"
+            "  -p port     server port (default 123)\n"
+            "  -n runs     number of syncs to perform (default 1)\n"
+            "  -r retries  retries per sync, as passed to syncTime() (default 5)\n"
+            "  -s          query one server at a time instead of all at once\n"
+            "  -b best     fan-out: pick the best of the first `best` responses\n"
+            "  -k samples  samples per sync; the lowest delay one is used (default %i)\n"
+            "  -z zone     timezone for the RTC, e.g. America/New_York (default UTC)\n"
+            "  -a key      authenticate with a key as in ntpd's keys file, \"1 SHA1 secret\"\n"
+            "  -B port     wait for the first server's broadcasts on `port`\n"
+            "  -D delay    broadcast: ms they take to arrive (default: measure it)\n"
+            "  -S port     serve time on `port` after syncing, until interrupted\n",
+            name, SYNC_DEFAULT_BURST);
+}
+
+int main(int argc, char *argv[])
+{
+    int runs = 1, retries = 5, servePort = 0, opt;
+
+    while((opt = getopt(argc, argv, "p:n:r:sb:k:z:a:B:D:S:h")) != -1) {
+        switch(opt) {
+            case 'p': syncConfig.port = atoi(optarg); break;
+            case 'n': runs = atoi(optarg); break;
+            case 'r': retries = atoi(optarg); break;
+            case 's': syncConfig.mode = SYNC_SEQUENTIAL; break;
+            case 'b': syncConfig.bestOf = atoi(optarg); break;
+            case 'k': syncConfig.burst = atoi(optarg); break;
+            case 'B':
+                syncConfig.mode = SYNC_BROADCAST;
+                syncConfig.broadcastPort = atoi(optarg);
+                break;
+            case 'D': syncConfig.broadcastDelayMs = atoi(optarg); break;
+            case 'S': servePort = atoi(optarg); break;
+            case 'z':
+                if(tzFind(optarg) == NULL) {
+                    fprintf(stderr, "unknown zone %s\n", optarg);
+                    return 2;
+                }
+                tzSetZone(tzFind(optarg));
+                break;
+            case 'a':
+                if(!authParseKey(optarg)) {
+                    fprintf(stderr, "bad key %s\n", optarg);
+                    return 2;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if(optind < argc) {
+        syncConfig.numOfServers = 0;
+        for(int i=optind; i<argc && syncConfig.numOfServers<SYNC_MAX_SERVERS; i++)
+            syncConfig.servers[syncConfig.numOfServers++] = argv[i];
+    }
+    if(runs < 1) runs = 1;
+
+    timebaseInit();
+    phaseInit();
+    if(storageInit()) {
+        driftLoad();
+        addrcacheLoad();
+    }
+    if(!dnsInit())
+        return 1;
+
+    uint64_t * took = calloc(runs, sizeof(*took));
+    int failures = 0;
+
+    for(int i=0; i<runs; i++) {
+        uint64_t start = shimMonotonicUs();
+        if(syncTime(retries)) failures++;
+        took[i] = shimMonotonicUs() - start;
+        logFlush(stdout);
+        printf("run %i: %llu us\n", i, (unsigned long long)took[i]);
+    }
+
+    addrcacheSave();
+    driftSave();
+    phaseSave();
+    syncShutdown();
+    logFlush(stdout);
+    logSave();
+
+    rtcTimeAndDate rtc;
+    if(shimLastRtcWrite(&rtc)) {
+        printf("rtc    : 20%02u-%02u-%02u %02u:%02u:%02u (weekday %u)\n",
+               rtc.year, rtc.month, rtc.day,
+               rtc.hours, rtc.minutes, rtc.seconds, rtc.weekday);
+    }
+
+    const struct RtcLinkStats * r = rtclinkStats();
+    if(r->numOfWrites > 0) {
+        printf("rtc ack: %lu of %lu writes, %lu timed out, "
+               "rtt %lu us (%lu to %lu us)\n",
+               (unsigned long)r->numOfAcks, (unsigned long)r->numOfWrites,
+               (unsigned long)r->numOfTimeouts, (unsigned long)r->lastRttUs,
+               (unsigned long)r->minRttUs, (unsigned long)r->maxRttUs);
+    }
+
+    if(syncConfig.mode == SYNC_FANOUT) {
+        const struct Fanout * f = syncLastFanout();
+        for(size_t i=0; i<f->numOfServers; i++) {
+            struct in_addr a = { .s_addr = htonl(f->servers[i].addr) };
+            printf("server : %s:%u (%s) %li ms%s\n",
+                   inet_ntoa(a), f->servers[i].pInfo->port,
+                   f->servers[i].pInfo->pServerName,
+                   (long)f->servers[i].latencyMs, i==f->best? " *" : "");
+        }
+    }
+
+    const struct SyncProgress * p = syncProgress();
+    if(p->samples > 0) {
+        printf("offset : %lli ms (delay %lli ms)\n", (long long)p->offsetMs,
+               (long long)p->delayMs);
+        printf("spread : %lli ms over %i samples\n", (long long)p->spreadMs,
+               p->samples);
+    }
+
+    const struct DriftState * d = driftState();
+    printf("drift  : %li ppb from %lu syncs, next sync due at %lli\n",
+           (long)d->ppb, (unsigned long)d->numOfEstimates,
+           (long long)driftNextSyncSec());
+    phasePrintBreakdown();
+
+    qsort(took, runs, sizeof(*took), compareUs);
+    printf("runs   : %i (%i failed)\n", runs, failures);
+    printf("min    : %llu us\n", (unsigned long long)took[0]);
+    printf("median : %llu us\n", (unsigned long long)took[runs/2]);
+    printf("max    : %llu us\n", (unsigned long long)took[runs-1]);
+    if(servePort > 0)
+        serve(servePort);
+
+    free(took);
+    return failures ? 1 : 0;
+}
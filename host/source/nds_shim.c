@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <nds.h>
+#include <dswifi9.h>
+#include "nds_shim.h"
+#include "ndsntp_fifo.h"
+
+/* Length of a DS frame in microseconds (59.8261 Hz). */
+#define SHIM_VBLANK_US      16715
+/* How often a wait for incoming packets wakes up. */
+#define SHIM_PACKET_POLL_US 250
+/* How long the pretend ARM7 takes to answer an RTC write, once its scheduled
+ * delay is up. Setting and reading back the RTC over its serial bus takes
+ * about this long on the DS. */
+#define SHIM_ARM7_REPLY_US  600
+/* Longest a wait sleeps when nothing the host can deliver would end it, such
+ * as a key press. */
+#define SHIM_IDLE_MAX_US    1000000
+
+static rtcTimeAndDate shimRtc;
+static uint32_t shimRtcWrites;
+
+/* One answer from the pretend ARM7, held back until it is due. */
+static struct NdsntpRtcReply shimReply;
+static bool shimReplyQueued;
+static uint64_t shimReplyDueUs;
+
+static vu16 shimTimerCr[4];
+static vu16 shimTimerValue[4];
+static uint64_t shimTimerStart[4];
+/* When a timerStart() timer overflows next, and what to call then. */
+static uint64_t shimTimerAlarmUs[4];
+static uint64_t shimTimerPeriodUs[4];
+static VoidFn shimTimerCallback[4];
+
+static vu16 shimKeyCnt;
+
+uint64_t shimMonotonicUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+vu16 * shimTimerControl(int timer)
+{
+    return &shimTimerCr[timer & 3];
+}
+
+/* Count of a timer, in a range wide enough to cascade from. */
+static uint64_t shimTimerCount(int timer)
+{
+    static const unsigned int shift[4] = { 0, 6, 8, 10 };
+    uint16_t cr = shimTimerCr[timer];
+
+    if(!(cr & TIMER_ENABLE)) {
+        shimTimerStart[timer] = 0;
+        return 0;
+    }
+    if(cr & TIMER_CASCADE)
+        return timer > 0 ? shimTimerCount(timer - 1) >> 16 : 0;
+
+    /* The first read after enabling starts the timer. */
+    uint64_t now = shimMonotonicUs();
+    if(shimTimerStart[timer] == 0)
+        shimTimerStart[timer] = now;
+    uint64_t us = now - shimTimerStart[timer];
+    uint64_t cycles = us / 1000000 * BUS_CLOCK + us % 1000000 * BUS_CLOCK / 1000000;
+    return cycles >> shift[cr & 3];
+}
+
+vu16 * shimTimerData(int timer)
+{
+    timer &= 3;
+    shimTimerValue[timer] = shimTimerCount(timer);
+    return &shimTimerValue[timer];
+}
+
+void timerStart(int timer, ClockDivider divider, u16 ticks, VoidFn callback)
+{
+    static const unsigned int shift[4] = { 0, 6, 8, 10 };
+    timer &= 3;
+    uint64_t cycles = (uint64_t)(0x10000 - ticks) << shift[divider & 3];
+    shimTimerPeriodUs[timer] = cycles * 1000000 / BUS_CLOCK;
+    if(shimTimerPeriodUs[timer] == 0)
+        shimTimerPeriodUs[timer] = 1;
+    shimTimerAlarmUs[timer] = shimMonotonicUs() + shimTimerPeriodUs[timer];
+    shimTimerCallback[timer] = callback;
+    shimTimerCr[timer] = TIMER_ENABLE | TIMER_IRQ_REQ | (divider & 3);
+    shimTimerStart[timer] = 0;
+}
+
+u16 timerStop(int timer)
+{
+    timer &= 3;
+    u16 elapsed = shimTimerCount(timer);
+    shimTimerCr[timer] = 0;
+    shimTimerAlarmUs[timer] = 0;
+    return elapsed;
+}
+
+void irqEnable(uint32_t irq)
+{
+    (void)irq;
+}
+
+vu16 * shimKeyControl(void)
+{
+    return &shimKeyCnt;
+}
+
+void scanKeys(void)
+{
+}
+
+uint32_t keysHeld(void)
+{
+    return 0;
+}
+
+uint32_t keysDown(void)
+{
+    return 0;
+}
+
+void cothread_yield_irq(uint32_t flag)
+{
+    if(flag == 0)
+        return;
+
+    /* Sleep until the next frame boundary, like the ARM9 halting until the
+     * VBlank interrupt fires. On the DS, dswifi wakes the ARM9 through the
+     * FIFO when a packet comes in; we can't see that here, so waiting on it
+     * wakes up every SHIM_PACKET_POLL_US instead. Timers started with
+     * timerStart() wake it when they overflow. */
+    uint64_t now = shimMonotonicUs();
+    uint64_t next = now + SHIM_IDLE_MAX_US;
+    int alarm = -1;
+    if(flag & IRQ_VBLANK)
+        next = (now / SHIM_VBLANK_US + 1) * SHIM_VBLANK_US;
+    if((flag & IRQ_FIFO_NOT_EMPTY) && next - now > SHIM_PACKET_POLL_US)
+        next = now + SHIM_PACKET_POLL_US;
+    for(int t=0; t<4; t++) {
+        if(!(flag & IRQ_TIMER(t)) || shimTimerAlarmUs[t] == 0 ||
+           shimTimerAlarmUs[t] >= next)
+            continue;
+        next = shimTimerAlarmUs[t] > now ? shimTimerAlarmUs[t] : now;
+        alarm = t;
+    }
+
+    struct timespec ts = {
+        .tv_sec = (next - now) / 1000000,
+        .tv_nsec = ((next - now) % 1000000) * 1000,
+    };
+    while(nanosleep(&ts, &ts) == -1 && errno == EINTR);
+
+    if(alarm >= 0) {
+        /* The timer reloads and keeps going until the callback stops it. */
+        shimTimerAlarmUs[alarm] += shimTimerPeriodUs[alarm];
+        if(shimTimerCallback[alarm] != NULL)
+            shimTimerCallback[alarm]();
+    }
+}
+
+void cothread_yield(void)
+{
+}
+
+bool fifoSendDatamsg(int channel, int num_bytes, void *data_array)
+{
+    struct NdsntpRtcRequest request;
+    if(channel != FIFO_NDSNTP || num_bytes != sizeof(request) || shimReplyQueued)
+        return false;
+
+    memcpy(&request, data_array, sizeof(request));
+    shimRtc = request.time;
+    shimRtcWrites++;
+
+    shimReply.seq = request.seq;
+    shimReply.status = request.delayUs <= NDSNTP_RTC_MAX_DELAY_US
+                       ? NDSNTP_RTC_OK : NDSNTP_RTC_BAD_REQUEST;
+    shimReply.readback = shimRtc;
+    shimReplyQueued = true;
+    shimReplyDueUs = shimMonotonicUs() + request.delayUs + SHIM_ARM7_REPLY_US;
+    return true;
+}
+
+bool fifoCheckDatamsg(int channel)
+{
+    return channel == FIFO_NDSNTP && shimReplyQueued
+           && shimMonotonicUs() >= shimReplyDueUs;
+}
+
+int fifoCheckDatamsgLength(int channel)
+{
+    return fifoCheckDatamsg(channel) ? (int)sizeof(shimReply) : -1;
+}
+
+int fifoGetDatamsg(int channel, int buffersize, uint8_t *destbuffer)
+{
+    if(!fifoCheckDatamsg(channel) || buffersize < (int)sizeof(shimReply))
+        return -1;
+    memcpy(destbuffer, &shimReply, sizeof(shimReply));
+    shimReplyQueued = false;
+    return sizeof(shimReply);
+}
+
+bool fifoSendValue32(int channel, uint32_t value32)
+{
+    (void)channel;
+    (void)value32;
+    return true;
+}
+
+bool shimLastRtcWrite(rtcTimeAndDate * pRtc)
+{
+    if(shimRtcWrites == 0)
+        return false;
+    *pRtc = shimRtc;
+    return true;
+}
+
+uint32_t shimRtcWriteCount(void)
+{
+    return shimRtcWrites;
+}
+
+struct in_addr Wifi_GetIPInfo(struct in_addr *pGateway, struct in_addr *pSnmask,
+                              struct in_addr *pDns1, struct in_addr *pDns2)
+{
+    struct in_addr ip = { .s_addr = htonl(INADDR_LOOPBACK) };
+    struct in_addr none = { .s_addr = 0 };
+    struct in_addr * dns[2] = { pDns1, pDns2 };
+    size_t n = 0;
+
+    if(pGateway) *pGateway = ip;
+    if(pSnmask) pSnmask->s_addr = htonl(0xFF000000);
+    if(pDns1) *pDns1 = none;
+    if(pDns2) *pDns2 = none;
+
+    FILE * f = fopen("/etc/resolv.conf", "r");
+    if(f == NULL)
+        return ip;
+
+    char line[256], addr[64];
+    while(n < 2 && fgets(line, sizeof(line), f) != NULL) {
+        if(sscanf(line, " nameserver %63s", addr) != 1)
+            continue;
+        struct in_addr a;
+        if(inet_pton(AF_INET, addr, &a) != 1)
+            continue;   // IPv6 servers are of no use to dswifi either
+        if(dns[n])
+            *dns[n] = a;
+        n++;
+    }
+    fclose(f);
+    return ip;
+}
@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+
+/* An NTP server for testing, which answers badly on purpose. Every request
+ * gets one fate, picked at random with the given odds or read back from a
+ * trace recorded earlier:
+ *
+ *   reply      a good response, after the delay and jitter
+ *   drop       no response
+ *   dup        the response, twice
+ *   reorder    the response, held back until after the next one goes out
+ *   badorig    a response whose originate time doesn't match the request
+ *   kod        a kiss-o'-death with the -K code
+ *   badmac     a response whose MAC doesn't check out (only with -a)
+ *
+ * The leap indicator, and the time the server claims, are set for every
+ * response. -t moves its clock, e.g. to just before the NTP era rolls over
+ * (2085978496, 2036-02-07T06:28:16Z). With -a every response is signed, and a
+ * request that isn't signed with the same key gets a crypto-NAK.
+ *
+ * With -w every fate and delay is written to a trace, one line per request;
+ * -r plays a trace back so a failing run can be repeated exactly.
+ *
+ * With -B it also broadcasts its time (mode 5) to 127.0.0.1 on the given
+ * port once a second, after the same delay as a response. -m applies to
+ * broadcasts too; the other faults only apply to requests.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "auth.h"
+
+#define FAKENTP_PORT        12300
+#define FAKENTP_SIZE        48
+#define FAKENTP_QUEUE       256
+#define FAKENTP_UNIX_TO_NTP 2208988800ULL
+/* A held back response goes out on its own if nothing else does by then. */
+#define FAKENTP_HOLD_US     1000000
+#define FAKENTP_BROADCAST_US 1000000
+
+enum Fate { FATE_REPLY, FATE_DROP, FATE_DUP, FATE_REORDER, FATE_BADORIG,
+            FATE_KOD, FATE_BADMAC, FATE_COUNT };
+
+static const char * const fateNames[FATE_COUNT] = {
+    [FATE_REPLY]    = "reply",
+    [FATE_DROP]     = "drop",
+    [FATE_DUP]      = "dup",
+    [FATE_REORDER]  = "reorder",
+    [FATE_BADORIG]  = "badorig",
+    [FATE_KOD]      = "kod",
+    [FATE_BADMAC]   = "badmac",
+};
+
+struct Options
+{
+    uint16_t port;
+    uint32_t delayUs;
+    uint32_t jitterUs;              /* Delay varies by up to this, either way */
+    unsigned percent[FATE_COUNT];   /* Odds of each fate but FATE_REPLY */
+    char kodCode[5];
+    uint8_t leap;
+    int64_t clockOffsetUs;          /* Added to the host clock */
+    uint64_t seed;
+    uint16_t broadcastPort;         /* 0 for no broadcasts */
+    FILE * record;
+    FILE * replay;
+    bool verbose;
+};
+
+/* A response waiting for its time to go out. */
+struct Pending
+{
+    uint64_t dueUs;
+    struct sockaddr_in to;
+    size_t length;
+    uint8_t packet[AUTH_PACKET_SIZE];
+};
+
+static struct Options opt = {
+    .port = FAKENTP_PORT,
+    .kodCode = "RATE",
+    .seed = 1,
+};
+static struct Pending queue[FAKENTP_QUEUE];
+static size_t queued;
+static struct Pending held;
+static bool holding;
+static uint64_t rng;
+static unsigned long counts[FATE_COUNT];
+static unsigned long broadcasts;
+static volatile sig_atomic_t stop;
+
+static uint64_t monotonicUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* What the server says the time was `agoUs` ago, in NTP format. Wraps into
+ * the next era like a real server's would. */
+static void serverTime(uint8_t * p, int64_t agoUs)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    int64_t us = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 +
+                 opt.clockOffsetUs - agoUs;
+    uint32_t seconds = (uint32_t)(us / 1000000 + FAKENTP_UNIX_TO_NTP);
+    uint32_t fractions = (uint32_t)(((uint64_t)(us % 1000000) << 32) / 1000000);
+    uint32_t be[2] = { htonl(seconds), htonl(fractions) };
+    memcpy(p, be, sizeof(be));
+}
+
+/* xorshift64*, so a seed gives the same run every time. */
+static uint32_t randomU32(void)
+{
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545f4914f6cdd1dULL) >> 32);
+}
+
+static enum Fate pickFate(uint32_t * pDelayUs)
+{
+    char line[64], name[16];
+    unsigned long seq, delay;
+
+    while(opt.replay != NULL) {
+        if(fgets(line, sizeof(line), opt.replay) == NULL) {
+            fprintf(stderr, "fakentp: trace ended, answering normally\n");
+            fclose(opt.replay);
+            opt.replay = NULL;
+            break;
+        }
+        if(line[0] == '#' ||
+           sscanf(line, "%lu,%15[^,],%lu", &seq, name, &delay) != 3)
+            continue;
+        for(int f=0; f<FATE_COUNT; f++) {
+            if(!strcmp(name, fateNames[f])) {
+                *pDelayUs = delay;
+                return f;
+            }
+        }
+    }
+
+    int64_t delayUs = opt.delayUs;
+    if(opt.jitterUs > 0)
+        delayUs += (int64_t)(randomU32() % (2 * opt.jitterUs + 1)) - opt.jitterUs;
+    *pDelayUs = delayUs > 0 ? delayUs : 0;
+
+    unsigned roll = randomU32() % 100;
+    for(int f=FATE_REPLY+1; f<FATE_COUNT; f++) {
+        if(roll < opt.percent[f])
+            return f;
+        roll -= opt.percent[f];
+    }
+    return FATE_REPLY;
+}
+
+/* Builds the response and returns its length, MAC included. */
+static size_t makeResponse(const uint8_t * pRequest, size_t requestLength,
+                           uint8_t * pResponse, const uint8_t * pRx,
+                           enum Fate fate)
+{
+    uint8_t version = (pRequest[0] >> 3) & 7;
+
+    memset(pResponse, 0, AUTH_PACKET_SIZE);
+    if(fate == FATE_KOD) {
+        pResponse[0] = 3 << 6 | version << 3 | 4;
+        memcpy(pResponse + 12, opt.kodCode, 4);
+        memcpy(pResponse + 24, pRequest + 40, 8);
+        return FAKENTP_SIZE + authSign(pResponse);
+    }
+
+    pResponse[0] = opt.leap << 6 | version << 3 | 4;
+    pResponse[1] = 2;                       /* Stratum */
+    pResponse[2] = pRequest[2];             /* Poll */
+    pResponse[3] = 0xec;                    /* Precision, about 60 ns */
+    pResponse[5] = 0x01;                    /* Root delay and dispersion, */
+    pResponse[9] = 0x01;                    /* about 4 ms each */
+    memcpy(pResponse + 12, "FAKE", 4);
+    serverTime(pResponse + 16, 64000000);   /* Reference, last poll */
+    memcpy(pResponse + 24, pRequest + 40, 8);
+    if(fate == FATE_BADORIG)
+        pResponse[31] ^= 0x5a;
+    memcpy(pResponse + 32, pRx, 8);
+    serverTime(pResponse + 40, 0);
+
+    /* A crypto-NAK is a MAC with key ID 0 and no digest. */
+    if(!authCheck(pRequest, requestLength))
+        return FAKENTP_SIZE + AUTH_KEY_ID_SIZE;
+    size_t length = FAKENTP_SIZE + authSign(pResponse);
+    if(fate == FATE_BADMAC && authEnabled())
+        pResponse[length - 1] ^= 0x5a;
+    return length;
+}
+
+/* Builds a broadcast and returns its length, MAC included. */
+static size_t makeBroadcast(uint8_t * pPacket)
+{
+    memset(pPacket, 0, AUTH_PACKET_SIZE);
+    pPacket[0] = opt.leap << 6 | 4 << 3 | 5;
+    pPacket[1] = 2;                         /* Stratum */
+    pPacket[2] = 6;                         /* Poll, 64 s as ntpd's default */
+    pPacket[3] = 0xec;
+    pPacket[5] = 0x01;
+    pPacket[9] = 0x01;
+    memcpy(pPacket + 12, "FAKE", 4);
+    serverTime(pPacket + 16, 64000000);
+    serverTime(pPacket + 40, 0);
+
+    size_t length = FAKENTP_SIZE + authSign(pPacket);
+    if(authEnabled() && randomU32() % 100 < opt.percent[FATE_BADMAC])
+        pPacket[length - 1] ^= 0x5a;
+    return length;
+}
+
+static void enqueue(const struct sockaddr_in * pTo, const uint8_t * pPacket,
+                    size_t length, uint64_t dueUs)
+{
+    if(queued == FAKENTP_QUEUE) {
+        fprintf(stderr, "fakentp: queue full, dropping\n");
+        return;
+    }
+    struct Pending * p = &queue[queued++];
+    p->dueUs = dueUs;
+    p->to = *pTo;
+    p->length = length;
+    memcpy(p->packet, pPacket, length);
+}
+
+static void sendPending(int sock, const struct Pending * p)
+{
+    if(sendto(sock, p->packet, p->length, 0, (const struct sockaddr *)&p->to,
+              sizeof(p->to)) < 0)
+        perror("fakentp: sendto");
+}
+
+/* Sends what is due, and a held back response after the first of them.
+ * Returns how long poll() may sleep. */
+static int sendDue(int sock)
+{
+    uint64_t now = monotonicUs();
+    int64_t nextUs = -1;
+    bool sent = false;
+
+    for(size_t i=0; i<queued; ) {
+        if(queue[i].dueUs <= now) {
+            sendPending(sock, &queue[i]);
+            queue[i] = queue[--queued];
+            sent = true;
+            continue;
+        }
+        int64_t wait = queue[i].dueUs - now;
+        if(nextUs < 0 || wait < nextUs)
+            nextUs = wait;
+        i++;
+    }
+
+    if(holding && (sent || held.dueUs <= now)) {
+        sendPending(sock, &held);
+        holding = false;
+    }
+    if(holding) {
+        int64_t wait = held.dueUs - now;
+        if(nextUs < 0 || wait < nextUs)
+            nextUs = wait;
+    }
+    return nextUs < 0 ? -1 : (int)((nextUs + 999) / 1000);
+}
+
+static void handleRequest(int sock, const uint8_t * pRequest, size_t length,
+                          const struct sockaddr_in * pFrom, uint64_t seq)
+{
+    uint8_t rx[8], response[AUTH_PACKET_SIZE];
+
+    serverTime(rx, 0);
+    if(length < FAKENTP_SIZE || (pRequest[0] & 7) != 3)
+        return;
+
+    uint32_t delayUs;
+    enum Fate fate = pickFate(&delayUs);
+    counts[fate]++;
+    if(opt.record != NULL) {
+        fprintf(opt.record, "%llu,%s,%lu\n", (unsigned long long)seq,
+                fateNames[fate], (unsigned long)delayUs);
+        fflush(opt.record);
+    }
+    if(opt.verbose)
+        fprintf(stderr, "%llu %s:%u %s %lu us\n", (unsigned long long)seq,
+                inet_ntoa(pFrom->sin_addr), ntohs(pFrom->sin_port),
+                fateNames[fate], (unsigned long)delayUs);
+
+    if(fate == FATE_DROP)
+        return;
+    size_t responseLength = makeResponse(pRequest, length, response, rx, fate);
+    uint64_t dueUs = monotonicUs() + delayUs;
+
+    if(fate == FATE_REORDER) {
+        if(holding)
+            sendPending(sock, &held);
+        held.dueUs = dueUs + FAKENTP_HOLD_US;
+        held.to = *pFrom;
+        held.length = responseLength;
+        memcpy(held.packet, response, responseLength);
+        holding = true;
+        return;
+    }
+    enqueue(pFrom, response, responseLength, dueUs);
+    if(fate == FATE_DUP)
+        enqueue(pFrom, response, responseLength, dueUs);
+}
+
+static void onSignal(int sig)
+{
+    stop = 1;
+}
+
+static void usage(const char * name)
+{
+    fprintf(stderr,
+            "usage: %s [-p port] [-d ms] [-j ms] [-l %%] [-u %%] [-o %%] [-b %%]\n"
+            "       [-k %%] [-K code] [-m %%] [-a key] [-L leap] [-t unix]\n"
+            "       [-s seed] [-w trace] [-r trace] [-B port] [-v]\n"
+            "  -p port   UDP port on 127.0.0.1 (default %i)\n"
+            "  -d ms     delay before each response\n"
+            "  -j ms     the delay varies by up to this much, either way\n"
+            "  -l %%      requests dropped\n"
+            "  -u %%      responses sent twice\n"
+            "  -o %%      responses sent after the next one\n"
+            "  -b %%      responses with the wrong originate time\n"
+            "  -k %%      kiss-o'-death responses\n"
+            "  -K code   kiss-o'-death code (default RATE)\n"
+            "  -m %%      responses with a bad MAC\n"
+            "  -a key    sign with a key as in ntpd's keys file, \"1 SHA1 secret\"\n"
+            "  -L leap   leap indicator, 0 to 3 (default 0)\n"
+            "  -t unix   the server's time at startup, as a Unix time\n"
+            "  -s seed   seed for the random faults (default 1)\n"
+            "  -w trace  write every request's fate and delay to a trace\n"
+            "  -r trace  replay a trace instead of rolling the dice\n"
+            "  -B port   also broadcast the time to this port every second\n"
+            "  -v        print every request\n",
+            name, FAKENTP_PORT);
+}
+
+int main(int argc, char *argv[])
+{
+    int c;
+
+    while((c = getopt(argc, argv, "p:d:j:l:u:o:b:k:K:m:a:L:t:s:w:r:B:vh")) != -1) {
+        switch(c) {
+            case 'p': opt.port = atoi(optarg); break;
+            case 'd': opt.delayUs = atoi(optarg) * 1000; break;
+            case 'j': opt.jitterUs = atoi(optarg) * 1000; break;
+            case 'l': opt.percent[FATE_DROP] = atoi(optarg); break;
+            case 'u': opt.percent[FATE_DUP] = atoi(optarg); break;
+            case 'o': opt.percent[FATE_REORDER] = atoi(optarg); break;
+            case 'b': opt.percent[FATE_BADORIG] = atoi(optarg); break;
+            case 'k': opt.percent[FATE_KOD] = atoi(optarg); break;
+            case 'K': strncpy(opt.kodCode, optarg, 4); break;
+            case 'm': opt.percent[FATE_BADMAC] = atoi(optarg); break;
+            case 'a':
+                if(!authParseKey(optarg)) {
+                    fprintf(stderr, "fakentp: bad key %s\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'L': opt.leap = atoi(optarg) & 3; break;
+            case 't': {
+                struct timespec ts;
+                clock_gettime(CLOCK_REALTIME, &ts);
+                opt.clockOffsetUs = (strtoll(optarg, NULL, 10) - ts.tv_sec) *
+                                    1000000 - ts.tv_nsec / 1000;
+                break;
+            }
+            case 's': opt.seed = strtoull(optarg, NULL, 10); break;
+            case 'w':
+                if((opt.record = fopen(optarg, "w")) == NULL) {
+                    perror(optarg);
+                    return 1;
+                }
+                fprintf(opt.record, "# seq,fate,delay_us\n");
+                break;
+            case 'r':
+                if((opt.replay = fopen(optarg, "r")) == NULL) {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'B': opt.broadcastPort = atoi(optarg); break;
+            case 'v': opt.verbose = true; break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    unsigned total = 0;
+    for(int f=0; f<FATE_COUNT; f++)
+        total += opt.percent[f];
+    if(total > 100) {
+        fprintf(stderr, "fakentp: the odds add up to more than 100%%\n");
+        return 2;
+    }
+    rng = opt.seed != 0 ? opt.seed : 1;
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(opt.port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    if(sock < 0 || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("fakentp: bind");
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = onSignal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    fprintf(stderr, "fakentp: listening on 127.0.0.1:%u\n", opt.port);
+
+    struct sockaddr_in broadcastTo = {
+        .sin_family = AF_INET,
+        .sin_port = htons(opt.broadcastPort),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    uint64_t nextBroadcastUs = monotonicUs();
+
+    uint64_t seq = 0;
+    while(!stop) {
+        if(opt.broadcastPort != 0 && monotonicUs() >= nextBroadcastUs) {
+            uint8_t packet[AUTH_PACKET_SIZE];
+            size_t length = makeBroadcast(packet);
+            enqueue(&broadcastTo, packet, length, monotonicUs() + opt.delayUs);
+            nextBroadcastUs += FAKENTP_BROADCAST_US;
+            broadcasts++;
+        }
+
+        struct pollfd pfd = { .fd = sock, .events = POLLIN };
+        int timeoutMs = sendDue(sock);
+        if(opt.broadcastPort != 0) {
+            uint64_t now = monotonicUs();
+            int untilMs = nextBroadcastUs > now ?
+                          (int)((nextBroadcastUs - now + 999) / 1000) : 0;
+            if(timeoutMs < 0 || untilMs < timeoutMs)
+                timeoutMs = untilMs;
+        }
+        if(poll(&pfd, 1, timeoutMs) < 0) {
+            if(errno == EINTR)
+                continue;
+            perror("fakentp: poll");
+            break;
+        }
+        if(!(pfd.revents & POLLIN))
+            continue;
+
+        uint8_t request[FAKENTP_SIZE * 2];
+        struct sockaddr_in from;
+        socklen_t fromLength = sizeof(from);
+        ssize_t n = recvfrom(sock, request, sizeof(request), 0,
+                             (struct sockaddr *)&from, &fromLength);
+        if(n > 0)
+            handleRequest(sock, request, n, &from, seq++);
+    }
+
+    fprintf(stderr, "fakentp: %llu requests:", (unsigned long long)seq);
+    for(int f=0; f<FATE_COUNT; f++)
+        fprintf(stderr, " %s %lu", fateNames[f], counts[f]);
+    if(opt.broadcastPort != 0)
+        fprintf(stderr, ", %lu broadcasts", broadcasts);
+    fprintf(stderr, "\n");
+    if(opt.record != NULL)
+        fclose(opt.record);
+    close(sock);
+    return 0;
+}
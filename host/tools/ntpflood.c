@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+
+/* Load generator for the NTP server mode. Sends client requests to a server
+ * from a number of sockets at once, as a room of consoles would, and reports
+ * the replies per second, the round trip times and how far off the server's
+ * clock is from ours. A request that isn't answered within -T ms is counted
+ * as lost.
+ *
+ * Requests are told apart by the low bits of their transmit timestamp, which
+ * the server echoes back as the originate timestamp.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "auth.h"
+
+#define NTPFLOOD_PORT           12300
+#define NTPFLOOD_SIZE           48
+#define NTPFLOOD_MAX_CLIENTS    64
+/* Requests in flight are told apart by this many low bits of the fraction. */
+#define NTPFLOOD_SLOT_BITS      12
+#define NTPFLOOD_SLOTS          (1 << NTPFLOOD_SLOT_BITS)
+#define NTPFLOOD_UNIX_TO_NTP    2208988800ULL
+
+struct Options
+{
+    struct in_addr addr;
+    uint16_t port;
+    unsigned clients;           /* Sockets to send from */
+    unsigned window;            /* Requests in flight, at most */
+    unsigned rate;              /* Requests per second, 0 for as fast as it can */
+    unsigned seconds;
+    unsigned timeoutMs;
+};
+
+/* A request in flight. */
+struct Slot
+{
+    bool busy;
+    uint64_t sentUs;            /* monotonicUs() */
+    int64_t t1Us;               /* Its transmit time, realtime */
+};
+
+static struct Options opt = {
+    .port = NTPFLOOD_PORT,
+    .clients = 8,
+    .window = 64,
+    .seconds = 5,
+    .timeoutMs = 1000,
+};
+static struct Slot slots[NTPFLOOD_SLOTS];
+static unsigned inFlight;
+static unsigned nextSlot;
+static volatile sig_atomic_t stop;
+
+/* Round trips in microseconds, for the percentiles. */
+static uint32_t * rtts;
+static size_t numOfRtts, maxRtts;
+static unsigned long sent, received, lost, naks, badMacs, strays;
+static double offsetSumUs;
+static int64_t minOffsetUs = INT64_MAX, maxOffsetUs = INT64_MIN;
+
+static uint64_t monotonicUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int64_t realtimeUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint32_t loadBe32(const uint8_t * p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static void storeBe32(uint8_t * p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+/* An NTP timestamp to Unix microseconds, in the era around now. */
+static int64_t unixUsFromNtp(const uint8_t * p)
+{
+    int64_t s = (int64_t)loadBe32(p) - NTPFLOOD_UNIX_TO_NTP;
+    if(s < 0)
+        s += 4294967296LL;
+    return s * 1000000 + (int64_t)(((uint64_t)loadBe32(p + 4) * 1000000) >> 32);
+}
+
+static void onSignal(int sig)
+{
+    stop = 1;
+}
+
+static bool sendRequest(int sock)
+{
+    for(unsigned i=0; i<NTPFLOOD_SLOTS; i++) {
+        unsigned s = (nextSlot + i) % NTPFLOOD_SLOTS;
+        if(slots[s].busy)
+            continue;
+        nextSlot = s + 1;
+
+        uint8_t packet[AUTH_PACKET_SIZE] = { 4 << 3 | 3 };
+        int64_t now = realtimeUs();
+        uint32_t seconds = (uint32_t)(now / 1000000 + NTPFLOOD_UNIX_TO_NTP);
+        uint32_t fractions = (uint32_t)(((uint64_t)(now % 1000000) << 32) / 1000000);
+        fractions = (fractions & ~(uint32_t)(NTPFLOOD_SLOTS - 1)) | s;
+        storeBe32(packet + 40, seconds);
+        storeBe32(packet + 44, fractions);
+        size_t length = NTPFLOOD_SIZE + authSign(packet);
+
+        struct sockaddr_in to = {
+            .sin_family = AF_INET,
+            .sin_port = htons(opt.port),
+            .sin_addr = opt.addr,
+        };
+        if(sendto(sock, packet, length, 0, (struct sockaddr *)&to, sizeof(to)) < 0) {
+            if(errno != EAGAIN && errno != ENOBUFS)
+                perror("ntpflood: sendto");
+            return false;
+        }
+        slots[s] = (struct Slot) {
+            .busy = true,
+            .sentUs = monotonicUs(),
+            .t1Us = unixUsFromNtp(packet + 40),
+        };
+        inFlight++;
+        sent++;
+        return true;
+    }
+    return false;
+}
+
+static void receiveReply(int sock)
+{
+    uint8_t packet[AUTH_PACKET_SIZE];
+    ssize_t n = recv(sock, packet, sizeof(packet), MSG_DONTWAIT);
+    if(n < 0)
+        return;
+    uint64_t rxUs = monotonicUs();
+    int64_t t4 = realtimeUs();
+
+    unsigned s = loadBe32(packet + 28) & (NTPFLOOD_SLOTS - 1);
+    if(n < NTPFLOOD_SIZE || (packet[0] & 7) != 4 || !slots[s].busy) {
+        strays++;
+        return;
+    }
+    slots[s].busy = false;
+    inFlight--;
+    if(n == NTPFLOOD_SIZE + AUTH_KEY_ID_SIZE && authEnabled()) {
+        naks++;
+        return;
+    }
+    if(!authCheck(packet, n)) {
+        badMacs++;
+        return;
+    }
+    received++;
+
+    if(numOfRtts == maxRtts) {
+        maxRtts = maxRtts ? maxRtts * 2 : 65536;
+        rtts = realloc(rtts, maxRtts * sizeof(*rtts));
+    }
+    rtts[numOfRtts++] = rxUs - slots[s].sentUs;
+
+    int64_t t2 = unixUsFromNtp(packet + 32), t3 = unixUsFromNtp(packet + 40);
+    int64_t offset = ((t2 - slots[s].t1Us) + (t3 - t4)) / 2;
+    offsetSumUs += offset;
+    if(offset < minOffsetUs) minOffsetUs = offset;
+    if(offset > maxOffsetUs) maxOffsetUs = offset;
+}
+
+/* Gives up on requests that have waited longer than the timeout. */
+static void expire(void)
+{
+    uint64_t now = monotonicUs();
+    for(unsigned s=0; s<NTPFLOOD_SLOTS; s++) {
+        if(slots[s].busy && now - slots[s].sentUs > opt.timeoutMs * 1000ULL) {
+            slots[s].busy = false;
+            inFlight--;
+            lost++;
+        }
+    }
+}
+
+static int compareU32(const void * a, const void * b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(const char * name)
+{
+    fprintf(stderr,
+            "usage: %s [-p port] [-c clients] [-w window] [-r rate] [-t seconds]\n"
+            "       [-T ms] [-a key] [server]\n"
+            "  -p port     server port (default %i)\n"
+            "  -c clients  sockets to send from, up to %i (default 8)\n"
+            "  -w window   requests in flight, up to %i (default 64)\n"
+            "  -r rate     requests per second (default: as many as are answered)\n"
+            "  -t seconds  how long to run (default 5)\n"
+            "  -T ms       a request not answered by then is lost (default 1000)\n"
+            "  -a key      sign with a key as in ntpd's keys file, \"1 SHA1 secret\"\n"
+            "  server      IPv4 address (default 127.0.0.1)\n",
+            name, NTPFLOOD_PORT, NTPFLOOD_MAX_CLIENTS, NTPFLOOD_SLOTS);
+}
+
+int main(int argc, char *argv[])
+{
+    int c;
+
+    opt.addr.s_addr = htonl(INADDR_LOOPBACK);
+    while((c = getopt(argc, argv, "p:c:w:r:t:T:a:h")) != -1) {
+        switch(c) {
+            case 'p': opt.port = atoi(optarg); break;
+            case 'c': opt.clients = atoi(optarg); break;
+            case 'w': opt.window = atoi(optarg); break;
+            case 'r': opt.rate = atoi(optarg); break;
+            case 't': opt.seconds = atoi(optarg); break;
+            case 'T': opt.timeoutMs = atoi(optarg); break;
+            case 'a':
+                if(!authParseKey(optarg)) {
+                    fprintf(stderr, "ntpflood: bad key %s\n", optarg);
+                    return 2;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if(optind < argc && inet_aton(argv[optind], &opt.addr) == 0) {
+        fprintf(stderr, "ntpflood: bad address %s\n", argv[optind]);
+        return 2;
+    }
+    if(opt.clients < 1 || opt.clients > NTPFLOOD_MAX_CLIENTS ||
+       opt.window < 1 || opt.window > NTPFLOOD_SLOTS) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct pollfd pfds[NTPFLOOD_MAX_CLIENTS];
+    for(unsigned i=0; i<opt.clients; i++) {
+        pfds[i].fd = socket(AF_INET, SOCK_DGRAM, 0);
+        pfds[i].events = POLLIN;
+        if(pfds[i].fd < 0) {
+            perror("ntpflood: socket");
+            return 1;
+        }
+    }
+
+    struct sigaction sa = { .sa_handler = onSignal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    uint64_t start = monotonicUs(), end = start + opt.seconds * 1000000ULL;
+    uint64_t nextPrintUs = start + 1000000;
+    unsigned long lastReceived = 0;
+    unsigned client = 0;
+    while(!stop) {
+        uint64_t now = monotonicUs();
+        if(now >= end && inFlight == 0)
+            break;
+        if(now >= end + opt.timeoutMs * 1000ULL)
+            break;
+
+        /* Top up the window, or keep to the rate. */
+        if(now < end) {
+            uint64_t due = opt.rate ? (now - start) * opt.rate / 1000000 + 1 : ~0ULL;
+            while(inFlight < opt.window && sent < due) {
+                if(!sendRequest(pfds[client].fd))
+                    break;
+                client = (client + 1) % opt.clients;
+            }
+        }
+
+        if(poll(pfds, opt.clients, 1) < 0 && errno != EINTR) {
+            perror("ntpflood: poll");
+            break;
+        }
+        for(unsigned i=0; i<opt.clients; i++) {
+            if(pfds[i].revents & POLLIN)
+                receiveReply(pfds[i].fd);
+        }
+        expire();
+
+        if(monotonicUs() >= nextPrintUs) {
+            nextPrintUs += 1000000;
+            printf("%lu replies/s, %u in flight\n", received - lastReceived,
+                   inFlight);
+            lastReceived = received;
+        }
+    }
+    double seconds = (monotonicUs() - start) / 1e6;
+
+    printf("sent   : %lu requests in %.1f s, %.0f/s\n", sent, seconds,
+           sent / seconds);
+    printf("replies: %lu, %.0f/s; %lu lost, %lu naks, %lu bad MACs, %lu strays\n",
+           received, received / seconds, lost, naks, badMacs, strays);
+    if(numOfRtts > 0) {
+        qsort(rtts, numOfRtts, sizeof(*rtts), compareU32);
+        printf("rtt    : p50 %u us, p99 %u us, max %u us\n",
+               rtts[numOfRtts / 2], rtts[numOfRtts * 99 / 100],
+               rtts[numOfRtts - 1]);
+        printf("offset : mean %.0f us (%lli to %lli us)\n",
+               offsetSumUs / numOfRtts, (long long)minOffsetUs,
+               (long long)maxOffsetUs);
+    }
+    for(unsigned i=0; i<opt.clients; i++)
+        close(pfds[i].fd);
+    free(rtts);
+    return received > 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef ADDRCACHE_H_
+#define ADDRCACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "dns.h"
+
+#define ADDRCACHE_FILE          "addrcache.bin"
+#define ADDRCACHE_MAX_ENTRIES   DNS_MAX_QUERIES
+
+struct AddrCacheEntry
+{
+    char name[DNS_MAX_NAME];
+    int64_t expires;                /* UTC second at which the entry goes stale */
+    uint32_t numOfAddrs;
+    uint32_t addrs[DNS_MAX_RECORDS];    /* Host byte order */
+};
+
+/**
+ * @brief Reads the cache saved by a previous run. Expired entries are skipped.
+ */
+void addrcacheLoad(void);
+
+/**
+ * @brief Writes the cache to storage if it changed since it was loaded.
+ */
+bool addrcacheSave(void);
+
+/**
+ * @brief Keeps entries for at least `seconds`, whatever their TTL. NTP pool
+ * members stay in service for months, but the pool hands them out with TTLs
+ * of a few minutes to spread the load, so honouring the TTL means a DNS round
+ * trip on nearly every boot. 0, the default, honours it.
+ */
+void addrcacheSetMinTtl(uint32_t seconds);
+
+/**
+ * @brief Remembers the addresses a name resolved to, replacing what was there.
+ */
+void addrcacheStore(const char * name,
+                    const struct DnsRecord * pRecords,
+                    size_t numOfRecords);
+
+/**
+ * @brief Copies up to `max` unexpired addresses for `name` to `pRecords`, with
+ * the seconds left as their TTL. Returns how many were copied.
+ */
+size_t addrcacheLookup(const char * name,
+                       struct DnsRecord * pRecords,
+                       size_t max);
+
+/**
+ * @brief Forgets one address of `name`, e.g. because it stopped answering.
+ */
+void addrcacheDrop(const char * name, uint32_t addr);
+
+#endif  /* ifndef ADDRCACHE_H_ */
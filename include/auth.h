@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef AUTH_H_
+#define AUTH_H_
+
+/* Symmetric-key authentication as in RFC 5905 and ntpd's keys file. The MAC
+ * follows the 48-byte packet: a 32-bit key ID, then MD5 or SHA-1 of the key
+ * followed by the packet. The server has to have the same key under the same
+ * ID; a response it can't sign comes back with key ID 0 (a crypto-NAK).
+ *
+ * The key and the length of what is hashed never change, so the blocks fed to
+ * the hash are laid out once, padding included, when the key is set. A packet
+ * costs a copy of 48 bytes and two compressions.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <core_sntp_client.h>
+
+#define AUTH_KEY_ID_SIZE        4
+#define AUTH_MAX_DIGEST_SIZE    20
+#define AUTH_MAX_MAC_SIZE       (AUTH_KEY_ID_SIZE + AUTH_MAX_DIGEST_SIZE)
+#define AUTH_MAX_KEY_SIZE       32
+/* Room for a packet and its MAC. */
+#define AUTH_PACKET_SIZE        (SNTP_PACKET_BASE_SIZE + AUTH_MAX_MAC_SIZE)
+
+enum AuthType { AUTH_NONE, AUTH_MD5, AUTH_SHA1 };
+
+/**
+ * @brief Signs every request with `pKey` from now on, and only accepts
+ * responses signed with it. AUTH_NONE turns authentication off. Returns false
+ * if the key is empty or longer than AUTH_MAX_KEY_SIZE.
+ */
+bool authSetKey(uint32_t keyId, enum AuthType type,
+                const uint8_t * pKey, size_t keyLength);
+
+/**
+ * @brief authSetKey() from a line of an ntpd keys file, "1 SHA1 secret". As
+ * in ntpd, a secret of more than 20 characters is hex.
+ */
+bool authParseKey(const char * spec);
+
+/**
+ * @brief Whether a key is set.
+ */
+bool authEnabled(void);
+
+/**
+ * @brief Appends the MAC to the packet at `pPacket`, which must have room for
+ * AUTH_PACKET_SIZE bytes. Returns the size of the MAC, 0 with no key.
+ */
+size_t authSign(uint8_t * pPacket);
+
+/**
+ * @brief Whether the `length` bytes at `pPacket` are a packet signed with our
+ * key. Always true with no key.
+ */
+bool authCheck(const uint8_t * pPacket, size_t length);
+
+/**
+ * @brief The interface to hand to Sntp_Init(), or NULL with no key.
+ */
+const SntpAuthenticationInterface_t * authInterface(void);
+
+#endif  /* ifndef AUTH_H_ */
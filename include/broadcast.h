@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef BROADCAST_H_
+#define BROADCAST_H_
+
+/* Broadcast client (RFC 5905 mode 6). A server on the LAN broadcasts its time
+ * every so often in mode 5 packets; we only listen, so any number of consoles
+ * can sync without sending a thing. A broadcast says what the time was when
+ * it left, so the time it took to get here has to be known beforehand: it is
+ * either configured or measured with one ordinary exchange.
+ *
+ * Only plain broadcast. dswifi doesn't join multicast groups.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <core_sntp_client.h>
+#include "auth.h"
+#include "core_sntp_callbacks.h"
+
+struct Broadcast
+{
+    NetworkContext_t netContext;        /* Bound to the port we listen on */
+    const SntpServerInfo_t * pSource;   /* Server whose broadcasts we take */
+    uint32_t sourceAddr;                /* ...at this address, host byte order */
+    int32_t delayMs;                    /* One-way delay from it */
+    SntpTimestamp_t start;
+    uint32_t timeoutMs;
+    uint32_t numOfRejected;             /* From the source, but not usable */
+    SntpResponseData_t response;        /* Time, leap and offset, as of rxTime */
+    SntpTimestamp_t rxTime;
+    uint8_t buffer[AUTH_PACKET_SIZE];
+};
+
+/**
+ * @brief Opens a socket on `port`, on every interface. Returns false if it
+ * can't, for instance because something else has the port.
+ */
+bool broadcastOpen(struct Broadcast * pBroadcast, uint16_t port);
+
+/**
+ * @brief Waits for the next broadcast from `sourceAddr`, the address of
+ * `pSource`, which is taken to have been `delayMs` on the way.
+ */
+void broadcastListen(struct Broadcast * pBroadcast,
+                     const SntpServerInfo_t * pSource,
+                     uint32_t sourceAddr,
+                     int32_t delayMs,
+                     uint32_t timeoutMs);
+
+/**
+ * @brief Reads whatever has arrived. Returns SntpNoResponseReceived while
+ * waiting, SntpSuccess with a usable broadcast in pBroadcast->response, and
+ * SntpErrorResponseTimeout once `timeoutMs` has passed without one.
+ */
+SntpStatus_t broadcastPoll(struct Broadcast * pBroadcast);
+
+void broadcastClose(struct Broadcast * pBroadcast);
+
+#endif  /* ifndef BROADCAST_H_ */
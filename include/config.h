@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+/* Settings from ndsntp.ini, next to the other files in NDSNTP_DIR. Every key
+ * is optional:
+ *
+ *   ; Sync, write the RTC and exit without asking. Defaults to yes.
+ *   headless = yes
+ *   ; After a sync, answer NTP requests from other consoles until told to
+ *   ; stop. Headless syncs stay on the synced screen instead of exiting.
+ *   serve = no
+ *   ; A named zone, or a fixed offset such as -05:00. Not both.
+ *   zone = America/New_York
+ *   offset = +05:30
+ *   servers = us.pool.ntp.org, time.cloudflare.com
+ *   mode = fanout           ; or sequential, or broadcast
+ *   ; Broadcast mode: how long a broadcast takes to arrive. Without it, one
+ *   ; exchange with the server measures it.
+ *   broadcast_delay_ms = 2
+ *   best_of = 1
+ *   samples = 4
+ *   timeout_ms = 1000       ; longest wait for one response
+ *   retries = 5
+ *   port = 123
+ *   ; Keep resolved addresses on the card for at least this many seconds,
+ *   ; rather than for their DNS TTL, to skip DNS on most boots.
+ *   cache_min_ttl = 86400
+ *   ; Sign requests and check responses with this key, as in ntpd's keys
+ *   ; file: ID, MD5 or SHA1, and up to 20 characters or 64 hex digits.
+ *   key = 1 SHA1 0123456789abcdef0123456789abcdef01234567
+ *
+ * `;` and `#` start comments, and [sections] are ignored; a key can't have
+ * either in it.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "dns.h"
+#include "sync.h"
+
+#define CONFIG_FILE         "ndsntp.ini"
+
+struct Config
+{
+    bool headless;
+    bool serve;             /* Serve time after syncing, see server.h */
+    bool hasZone;           /* zone or offset was given */
+    int retries;            /* For syncStart() */
+    char servers[SYNC_MAX_SERVERS][DNS_MAX_NAME];
+};
+
+/**
+ * @brief Reads CONFIG_FILE and applies it to syncConfig and the local time.
+ * Returns false if there is no such file; unknown keys and bad values are
+ * logged and skipped.
+ */
+bool configLoad(void);
+
+/**
+ * @brief What was loaded, or the defaults.
+ */
+const struct Config * config(void);
+
+#endif  /* ifndef CONFIG_H_ */
@@ -7,13 +7,14 @@
 #ifndef CORE_SNTP_CALLBACKS_H_
 #define CORE_SNTP_CALLBACKS_H_
 
-#include <nds/fifocommon.h>
 #include <stdbool.h>
 #include <core_sntp_client.h>
 #include <sys/socket.h>
+#include "rtclink.h"
 
-#ifndef FIFO_NDSNTP
-#define FIFO_NDSNTP FIFO_USER_01
+/* Least time between sending a scheduled RTC write and its second edge. */
+#ifndef SNTP_RTC_WRITE_LEAD_US
+#define SNTP_RTC_WRITE_LEAD_US  2000
 #endif
 
 #ifndef RTC_IS_GMT
@@ -23,6 +24,9 @@
 struct NetworkContext
 {
     int udpSocket;
+    bool connected;         /* udpSocket is connected to peerAddr:peerPort */
+    uint32_t peerAddr;      /* IPv4 address, host byte order */
+    uint16_t peerPort;
 };
 
 bool sntpResolveDns(const SntpServerInfo_t * pServerAddr,
@@ -30,7 +34,49 @@ bool sntpResolveDns(const SntpServerInfo_t * pServerAddr,
 
 void sntpGetTime(SntpTimestamp_t * pCurrentTime);
 
-void sntpSetTime(   const SntpServerInfo_t * pTimeServer, 
+/**
+ * @brief Milliseconds from `a` to `b`.
+ */
+int64_t sntpTimestampDiffMs(const SntpTimestamp_t * a, const SntpTimestamp_t * b);
+
+/**
+ * @brief Moves a timestamp by `ms`, which may be negative.
+ */
+void sntpTimestampAddMs(SntpTimestamp_t * pTime, int64_t ms);
+
+/**
+ * @brief Network delay of an exchange: the round trip (T4 - T1) less the time
+ * the server held the request (T3 - T2). T2 and T3 are read from the response
+ * packet.
+ */
+int64_t sntpDelayMs(const SntpTimestamp_t * pRequestTime,
+                    const SntpTimestamp_t * pResponseRxTime,
+                    const void * pPacket);
+
+/**
+ * @brief Starts setting the RTC to `rtcUs` (microseconds since 1970, in
+ * whatever time the RTC keeps, as of now), which is `rtcOffsetSec` ahead of
+ * UTC. The write is scheduled for the next second edge of that time, so it
+ * lands without rounding error; the ARM7 confirms it up to about a second
+ * later. Returns false if the time is outside the years the RTC can hold or
+ * an earlier write is still pending.
+ */
+bool sntpWriteRtcAsync(int64_t rtcUs, int32_t rtcOffsetSec);
+
+/**
+ * @brief Checks on the write sntpWriteRtcAsync() started, without waiting.
+ * Returns RTCLINK_PENDING until the ARM7 answers. When it has, the first call
+ * to see it anchors the timebase and tells drift.c, or invalidates the
+ * timebase if the write failed, and returns how it went; later calls return
+ * the same until the next write.
+ */
+enum RtcLinkState sntpWriteRtcPoll(void);
+
+/**
+ * @brief Starts writing the server time to the RTC, see sntpWriteRtcAsync().
+ * Returns false if the server isn't believed or the write couldn't start.
+ */
+bool sntpSetTime(   const SntpServerInfo_t * pTimeServer, 
                     const SntpTimestamp_t * pServerTime,
                     int64_t clockOffsetMs,
                     SntpLeapSecondInfo_t leapSecondInfo);
@@ -47,4 +93,10 @@ int32_t sntpUdpRecv(NetworkContext_t * pNetworkContext,
                     void * pBuffer,
                     uint16_t bytesToRecv);
 
+/**
+ * @brief Throws away any datagrams waiting on the socket, such as late answers
+ * to an earlier request, so they don't get read as the answer to the next one.
+ */
+void sntpUdpDrain(int udpSocket);
+
 #endif  /* ifndef CORE_SNTP_CALLBACKS_H_ */
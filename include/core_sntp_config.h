@@ -26,54 +26,46 @@
 #define CORE_SNTP_CONFIG_H_
 
 #include <stdio.h>
+#include "log.h"
 
 #ifndef CORE_SNTP_LOG_LEVEL
 #define CORE_SNTP_LOG_LEVEL 6
 #endif
 
+/* The Log macros record into the ring buffer in log.h and return; messages are
+ * formatted only when printed or saved. Levels above CORE_SNTP_LOG_LEVEL are
+ * compiled out. */
+#define LOG_DISCARD( message )      do {} while(0)
+
 #ifndef LogError
-#   if CORE_SNTP_LOG_LEVEL >= 3
-#       define LogError( message )      \
-            printf("NTP-");            \
-            printf("ERR: ");           \
-            printf message;            \
-            printf("\n");
-#       endif
+#   if CORE_SNTP_LOG_LEVEL >= LOG_LEVEL_ERROR
+#       define LogError( message )  logWrite(LOG_LEVEL_ERROR, LOG_UNWRAP message)
+#   else
+#       define LogError( message )  LOG_DISCARD( message )
 #   endif
+#endif
 
 #ifndef LogWarn
-#   if CORE_SNTP_LOG_LEVEL >= 4
-#       define LogWarn( message )       \
-            printf("NTP-");            \
-            printf("WRN: ");           \
-            printf message;            \
-            printf("\n");
+#   if CORE_SNTP_LOG_LEVEL >= LOG_LEVEL_WARN
+#       define LogWarn( message )   logWrite(LOG_LEVEL_WARN, LOG_UNWRAP message)
 #   else
-#       define LogWarn ( message )
+#       define LogWarn( message )   LOG_DISCARD( message )
 #   endif
 #endif
 
 #ifndef LogInfo
-#   if CORE_SNTP_LOG_LEVEL >= 6
-#       define LogInfo( message )           \
-                printf("NTP-");            \
-                printf("inf: ");           \
-                printf message;            \
-                printf("\n");
+#   if CORE_SNTP_LOG_LEVEL >= LOG_LEVEL_INFO
+#       define LogInfo( message )   logWrite(LOG_LEVEL_INFO, LOG_UNWRAP message)
 #   else
-#        define LogInfo( message )
+#       define LogInfo( message )   LOG_DISCARD( message )
 #   endif
 #endif
 
 #ifndef LogDebug
-#   if CORE_SNTP_LOG_LEVEL >= 7
-#       define LogDebug( message )      \
-            printf("NTP-");            \
-            printf("dbg: ");           \
-            printf message;            \
-            printf("\n");
+#   if CORE_SNTP_LOG_LEVEL >= LOG_LEVEL_DEBUG
+#       define LogDebug( message )  logWrite(LOG_LEVEL_DEBUG, LOG_UNWRAP message)
 #   else
-#       define LogDebug( message )
+#       define LogDebug( message )  LOG_DISCARD( message )
 #   endif
 #endif
 
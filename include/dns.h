@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef DNS_H_
+#define DNS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DNS_PORT            53
+#define DNS_MAX_QUERIES     4
+#define DNS_MAX_RECORDS     8
+#define DNS_MAX_NAME        64
+#define DNS_RETRY_SECONDS   2       /* Resend after this long without an answer */
+#define DNS_TRIES           3
+
+enum DnsState { DNS_IDLE, DNS_PENDING, DNS_DONE, DNS_FAILED };
+
+struct DnsRecord
+{
+    uint32_t addr;      /* IPv4 address, host byte order */
+    uint32_t ttl;       /* Seconds, as given by the server */
+};
+
+struct DnsQuery
+{
+    enum DnsState state;
+    char name[DNS_MAX_NAME];
+    uint16_t id;
+    uint8_t tries;
+    uint8_t failures;   /* Servers that answered with an error */
+    uint64_t sentAtUs;  /* timebaseUs(), which the RTC being set doesn't move */
+    uint64_t expiresUs; /* ...when the shortest TTL runs out */
+    struct DnsRecord records[DNS_MAX_RECORDS];
+    size_t numOfRecords;
+};
+
+/**
+ * @brief Opens the resolver socket and takes dns1 and dns2 from the DHCP
+ * lease. Call it once the console is associated.
+ */
+bool dnsInit(void);
+
+/**
+ * @brief Closes the resolver socket. Pending queries fail.
+ */
+void dnsClose(void);
+
+/**
+ * @brief Starts resolving `name` (A records) on both DNS servers at the same
+ * time and returns right away. If the name was resolved before and its TTL
+ * has not run out, the previous answer is returned instead, and so is an
+ * unexpired entry of the address cache, which survives reboots. Dotted-quad
+ * names complete immediately. Returns NULL if there is no free query slot.
+ */
+const struct DnsQuery * dnsResolveAsync(const char * name);
+
+/**
+ * @brief Handles every answer that has arrived and resends queries that went
+ * unanswered. Never blocks; call it once per frame.
+ */
+void dnsPoll(void);
+
+/**
+ * @brief Returns the query for `name` as it stands, without sending anything.
+ * NULL if it was never asked, or its answer has expired.
+ */
+const struct DnsQuery * dnsLookup(const char * name);
+
+/**
+ * @brief Same as dnsResolveAsync(), but yields to the VBlank until the query
+ * is complete.
+ */
+const struct DnsQuery * dnsResolve(const char * name);
+
+/**
+ * @brief Forgets one address of `name`, here and in the address cache, so the
+ * next lookup skips it. Used when a server stops answering.
+ */
+void dnsDropAddress(const char * name, uint32_t addr);
+
+/**
+ * @brief Returns true while any query is waiting for an answer.
+ */
+bool dnsPending(void);
+
+#endif  /* ifndef DNS_H_ */
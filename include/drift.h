@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef DRIFT_H_
+#define DRIFT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DRIFT_FILE              "drift.bin"
+
+/* Syncs closer together than this are not used to estimate the drift: the
+ * error they measure is mostly the error of the measurement itself. */
+#define DRIFT_MIN_INTERVAL_S    (60*60)
+/* A watch crystal is good to a few tens of ppm. Anything far beyond this means
+ * the clock was set by hand in between, not that it drifted. */
+#define DRIFT_MAX_PPB           200000
+/* Writes land on a second edge, so even a fraction of a second can be taken
+ * out. Below this the prediction is not much better than the error. */
+#define DRIFT_CORRECT_MIN_MS    250
+/* The next sync is suggested for when the clock may be this far off... */
+#define DRIFT_TOLERANCE_MS      1000
+/* ...assuming the estimate is good to a tenth of the rate, or this, whichever
+ * is worse. Without an estimate a week is suggested. */
+#define DRIFT_UNCERTAINTY_PPB   1000
+#define DRIFT_DEFAULT_INTERVAL_S (7*24*60*60)
+#define DRIFT_MAX_INTERVAL_S    (30*24*60*60)
+
+/* What we know about the RTC. Times are UTC. An RTC error is RTC minus true
+ * time, with the timezone taken out.
+ */
+struct DriftState
+{
+    bool offsetKnown;           /* rtcOffsetSec is valid */
+    int32_t rtcOffsetSec;       /* Local minus UTC of the time in the RTC */
+    int64_t syncSec;            /* Last network sync, 0 if none */
+    int32_t residualMs;         /* RTC error right after it */
+    int32_t correctionMs;       /* Taken out by predictive corrections since */
+    int32_t ppb;                /* Drift rate; positive when the RTC runs fast */
+    uint32_t numOfEstimates;    /* Syncs that went into ppb */
+    int64_t leapSec;            /* Announced leap second takes effect, 0 if none */
+    int32_t leapMs;             /* RTC error it adds: +1000 inserted, -1000 deleted */
+};
+
+/**
+ * @brief Reads the state saved by a previous run.
+ */
+void driftLoad(void);
+
+/**
+ * @brief Writes the state to storage if it changed.
+ */
+bool driftSave(void);
+
+const struct DriftState * driftState(void);
+
+/**
+ * @brief Seconds to subtract from the RTC to get UTC; 0 until known.
+ */
+int32_t driftRtcOffsetSec(void);
+
+/**
+ * @brief Reports the RTC error a sync measured, just before the sync writes
+ * the RTC. Updates the drift estimate if the last sync was long enough ago.
+ */
+void driftMeasured(int64_t rtcErrorMs);
+
+/**
+ * @brief Called by whoever wrote the RTC: with the UTC second written, the
+ * resulting RTC error and the timezone offset that went into it.
+ */
+void driftRtcWritten(int64_t utcSec, int32_t residualMs, int32_t rtcOffsetSec);
+
+/**
+ * @brief Called when a server announces a leap second at the end of the
+ * month `utcSec` falls in. The RTC doesn't know about leap seconds, so once
+ * it passes the RTC is off by `leapMs`; the estimate and predictions take
+ * that into account.
+ */
+void driftLeapAnnounced(int64_t utcSec, int32_t leapMs);
+
+/**
+ * @brief RTC error the estimate predicts for now, in milliseconds. Returns
+ * false if there is no estimate.
+ */
+bool driftPredictedMs(int64_t * pErrorMs);
+
+/**
+ * @brief Takes the predicted error out of the RTC if it is big enough to be
+ * worth a write. Needs a good timebase anchor; returns false until it has
+ * had one, and while its write waits for the next second edge. Call it again
+ * until it returns true (whether or not it wrote); it does nothing after that.
+ */
+bool driftCorrect(void);
+
+/**
+ * @brief UTC second by which another network sync is advisable.
+ */
+int64_t driftNextSyncSec(void);
+
+#endif  /* ifndef DRIFT_H_ */
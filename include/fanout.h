@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef FANOUT_H_
+#define FANOUT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <core_sntp_client.h>
+#include "auth.h"
+
+#define FANOUT_MAX_SERVERS  8
+#define FANOUT_NONE         ((size_t)-1)
+
+/* One address of one configured server. */
+struct FanoutServer
+{
+    const SntpServerInfo_t * pInfo;     /* Server the address was resolved from */
+    uint32_t addr;                      /* IPv4 address, host byte order */
+    SntpTimestamp_t requestTime;        /* Transmit time of our request */
+    SntpResponseData_t response;
+    SntpStatus_t status;                /* SntpNoResponseReceived until answered */
+    int32_t latencyMs;                  /* Round trip time, -1 if no response */
+    int32_t delayMs;                    /* ...less the time the server held it */
+    bool excluded;                      /* Sent a kiss-o'-death; not asked again */
+};
+
+/* A set of requests sent to every address at once. Only the responses are
+ * waited for, so a slow or dead server costs nothing as long as another one
+ * answers.
+ */
+struct Fanout
+{
+    int udpSocket;
+    struct FanoutServer servers[FANOUT_MAX_SERVERS];
+    size_t numOfServers;
+    size_t numOfResponses;              /* Valid responses received */
+    size_t numOfAnswered;               /* Valid or rejected responses */
+    size_t best;                        /* Lowest delay response, or FANOUT_NONE */
+    size_t bestOf;                      /* Responses to wait for */
+    bool timedOut;                      /* Silent servers had the full timeout */
+    bool rateLimited;                   /* A server asked us to slow down */
+    SntpTimestamp_t start;
+    uint32_t timeoutMs;
+    uint8_t buffer[AUTH_PACKET_SIZE];       /* Room for a MAC */
+};
+
+/**
+ * @brief Empties the set. Must be called once before first use.
+ */
+void fanoutInit(struct Fanout * pFanout);
+
+/**
+ * @brief Empties the set but keeps the socket, so the next query doesn't
+ * have to open a new one.
+ */
+void fanoutClear(struct Fanout * pFanout);
+
+/**
+ * @brief Adds all the addresses each server resolved to, as the resolver has
+ * them now; servers whose lookup failed, or hasn't finished, are skipped.
+ * Never waits, so start the lookups first. Duplicates are skipped. Returns the
+ * number of addresses in the set.
+ */
+size_t fanoutAddServers(struct Fanout * pFanout,
+                        const SntpServerInfo_t * pServers,
+                        size_t numOfServers);
+
+/**
+ * @brief Sends a request to every address in the set, opening the socket
+ * the first time. The socket is kept open until fanoutClose(). The query is complete
+ * once `bestOf` valid responses have arrived (1 means the first valid one),
+ * every server answered, or `timeoutMs` elapsed. Servers that sent a kiss-o'-
+ * death are skipped; SntpRejectedResponse means there are none left.
+ */
+SntpStatus_t fanoutStart(struct Fanout * pFanout,
+                         size_t bestOf,
+                         uint32_t timeoutMs);
+
+/**
+ * @brief Reads every response that has arrived, waiting at most `waitMs` for
+ * the first one. Returns SntpNoResponseReceived while the query is still
+ * running, SntpSuccess once it is complete with at least one valid response
+ * (see pFanout->best) and SntpErrorResponseTimeout if none came in time.
+ */
+SntpStatus_t fanoutPoll(struct Fanout * pFanout, uint32_t waitMs);
+
+/**
+ * @brief Number of addresses that have not sent a kiss-o'-death.
+ */
+size_t fanoutUsable(const struct Fanout * pFanout);
+
+/**
+ * @brief Closes the socket. The results stay available, and the next
+ * fanoutStart() opens a new one.
+ */
+void fanoutClose(struct Fanout * pFanout);
+
+#endif  /* ifndef FANOUT_H_ */
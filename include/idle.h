@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Hardware timer that ends an idle wait. Timers 0 and 1 are the timebase. */
+#ifndef IDLE_TIMER
+#define IDLE_TIMER          2
+#endif
+
+/* Longest wait the timer can time at BUS_CLOCK/1024, about 2 s. Longer waits
+ * wake up once in between. */
+#define IDLE_MAX_TIMER_US   2000000
+
+struct IdleStats
+{
+    uint32_t wakeups;
+    uint64_t sleptUs;       /* Spent halted in idleWait() */
+    uint64_t sinceUs;       /* timebaseUs() at the last idleResetStats() */
+};
+
+/**
+ * @brief Lets a key press wake the ARM9. Call once at boot.
+ */
+void idleInit(void);
+
+/**
+ * @brief Halts until one of `irqMask` fires, a key is pressed, or `timeoutUs`
+ * passes; 0 waits with no timeout. While a key is held, or until the timebase
+ * has pinned down the second edge, every VBlank wakes it as well, so key
+ * repeat and timebaseUpdate() keep working.
+ */
+void idleWait(uint32_t irqMask, uint32_t timeoutUs);
+
+/**
+ * @brief How long until the RTC ticks over to the next second.
+ */
+uint32_t idleUsToNextSecond(void);
+
+const struct IdleStats * idleStats(void);
+void idleResetStats(void);
+
+#endif  /* ifndef IDLE_H_ */
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef LOG_H_
+#define LOG_H_
+
+/* Deferred-format logger behind the LogError()...LogDebug() macros in
+ * core_sntp_config.h. A log call copies the format pointer and its arguments
+ * into a ring buffer and returns; nothing is formatted or printed until
+ * someone reads the buffer, so logging costs next to nothing on the network
+ * path.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_FILE            "ndsntp.log"
+
+/* Same numbers as CORE_SNTP_LOG_LEVEL uses. */
+#define LOG_LEVEL_ERROR     3
+#define LOG_LEVEL_WARN      4
+#define LOG_LEVEL_INFO      6
+#define LOG_LEVEL_DEBUG     7
+
+/* Entries kept; older ones are overwritten. A power of two. */
+#define LOG_MAX_ENTRIES     64
+/* Arguments kept per entry, counting `*` widths. Any beyond are dropped and
+ * the rest of the format is printed as is. */
+#define LOG_MAX_ARGS        6
+/* Room for the strings passed with %s, which are copied since they may not
+ * outlive the call. Longer ones are cut short. */
+#define LOG_TEXT_BYTES      40
+
+/* Strips the parentheses off a Log macro's argument list. */
+#define LOG_UNWRAP(...)     __VA_ARGS__
+
+union LogArg
+{
+    long long i;
+    double d;
+    const void * p;
+};
+
+struct LogEntry
+{
+    uint64_t us;                /* timebaseUs() */
+    const char * format;        /* Must be a string literal */
+    uint8_t level;
+    uint8_t numOfArgs;
+    union LogArg args[LOG_MAX_ARGS];
+    char text[LOG_TEXT_BYTES];  /* %s arguments, one after another */
+};
+
+/**
+ * @brief Records a message. `format` is kept by pointer, so it must live
+ * forever; the arguments are copied.
+ */
+void logWrite(uint8_t level, const char * format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Entries still in the buffer, oldest first. `i` is below logCount().
+ */
+size_t logCount(void);
+const struct LogEntry * logGet(size_t i);
+
+/**
+ * @brief Formats an entry as "NTP-inf: message", without a newline. Returns
+ * what snprintf() would.
+ */
+int logFormat(const struct LogEntry * pEntry, char * pBuffer, size_t size);
+
+/**
+ * @brief Prints the entries not printed before to `f`, one per line.
+ */
+void logFlush(FILE * f);
+
+/**
+ * @brief Prints the last `n` entries to the console, printed before or not.
+ */
+void logPrintTail(size_t n);
+
+/**
+ * @brief Appends the entries not saved before to LOG_FILE, with the time
+ * since boot. Does nothing if there are none; cheap enough to call whenever
+ * the app is idle.
+ */
+bool logSave(void);
+
+#endif  /* ifndef LOG_H_ */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NDSNTP_FIFO_H_
+#define NDSNTP_FIFO_H_
+
+/* Messages between the ARM9 and the ARM7. Both sides include this header, so
+ * keep it free of anything only one of them has. */
+
+#include <stdint.h>
+#include <nds/fifocommon.h>
+#include <nds/system.h>
+
+#ifndef FIFO_NDSNTP
+#define FIFO_NDSNTP FIFO_USER_01
+#endif
+
+/* Longest delay a write can be scheduled with. The ARM7 times it with a
+ * 16-bit timer at BUS_CLOCK/1024, which runs out at two seconds. */
+#define NDSNTP_RTC_MAX_DELAY_US 2000000
+
+enum NdsntpRtcStatus
+{
+    NDSNTP_RTC_OK = 0,
+    NDSNTP_RTC_WRITE_FAILED,    /* rtcTimeAndDateSet() refused the date */
+    NDSNTP_RTC_BAD_REQUEST,     /* message of the wrong size, or delay too long */
+    NDSNTP_RTC_BUSY             /* an earlier write is still scheduled */
+};
+
+/**
+ * @brief ARM9 to ARM7: write `time` to the RTC `delayUs` microseconds after
+ * the request arrives, and restart the second tick there. Scheduled so that
+ * the write lands on the second edge of the time being written.
+ */
+struct NdsntpRtcRequest
+{
+    uint32_t seq;
+    uint32_t delayUs;
+    rtcTimeAndDate time;
+};
+
+/**
+ * @brief ARM7 to ARM9: the answer to the request with the same `seq`, sent
+ * right after the write. `readback` is what the RTC held then.
+ */
+struct NdsntpRtcReply
+{
+    uint32_t seq;
+    uint8_t status;             /* enum NdsntpRtcStatus */
+    rtcTimeAndDate readback;
+};
+
+#endif  /* ifndef NDSNTP_FIFO_H_ */
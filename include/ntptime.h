@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef NTPTIME_H_
+#define NTPTIME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <nds/system.h>
+#include <core_sntp_client.h>
+
+/* NTP seconds at the Unix epoch, 1970-01-01T00:00:00Z (RFC 868). */
+#define NTPTIME_UNIX_EPOCH      2208988800LL
+/* NTP seconds at 2000-01-01T00:00:00Z, in era 0. */
+#define NTPTIME_2000            3155673600LL
+/* Length of an NTP era, after which the 32-bit seconds wrap. */
+#define NTPTIME_ERA             4294967296LL
+
+/**
+ * @brief Converts an NTP timestamp to microseconds since the Unix epoch. The
+ * 32-bit seconds don't say which era they are in, so the timestamp is taken to
+ * fall between 2000 and 2136. That holds everything the RTC can store, and
+ * works across the 2036 rollover into era 1.
+ */
+int64_t ntptimeToUnixUs(const SntpTimestamp_t * pTime);
+
+/**
+ * @brief Converts microseconds since the Unix epoch to an NTP timestamp.
+ */
+void ntptimeFromUnixUs(int64_t unixUs, SntpTimestamp_t * pTime);
+
+/**
+ * @brief Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+ * Integer arithmetic only, valid for any year an int32_t holds.
+ */
+int64_t ntptimeDaysFromCivil(int32_t year, uint32_t month, uint32_t day);
+
+/**
+ * @brief The inverse of ntptimeDaysFromCivil().
+ */
+void ntptimeCivilFromDays(int64_t days, int32_t * pYear, uint32_t * pMonth,
+                          uint32_t * pDay);
+
+/**
+ * @brief Fills in an RTC date from seconds since the Unix epoch, in whatever
+ * time the RTC keeps (add the zone offset first for local time). No libc
+ * calendar calls. The RTC only keeps the last two digits of the year, so from
+ * 2100 on the date is stored with the century dropped; the weekday is still
+ * right. Returns false before 2000.
+ */
+bool ntptimeToRtc(int64_t unixSec, rtcTimeAndDate * pRtc);
+
+/**
+ * @brief The inverse of ntptimeToRtc(), taking the year to be in 2000-2099.
+ * The weekday is not looked at.
+ */
+int64_t ntptimeFromRtc(const rtcTimeAndDate * pRtc);
+
+#endif  /* ifndef NTPTIME_H_ */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef PHASE_H_
+#define PHASE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PHASE_FILE          "phases.csv"
+
+/* Events kept; older ones are overwritten. A power of two. */
+#define PHASE_MAX_EVENTS    128
+
+/* Points on the way from boot to synced that get a timestamp. */
+enum Phase
+{
+    PHASE_BOOT,
+    PHASE_WIFI_SEARCHING,
+    PHASE_WIFI_ASSOCIATING,
+    PHASE_WIFI_AUTHENTICATING,
+    PHASE_WIFI_DHCP,
+    PHASE_WIFI_ASSOCIATED,
+    PHASE_DNS_QUERY,        /* arg: attempt */
+    PHASE_DNS_ANSWER,       /* arg: addresses */
+    PHASE_SYNC_START,
+    PHASE_NTP_SEND,         /* arg: fan-out server index */
+    PHASE_NTP_RECV,         /* arg: fan-out server index */
+    PHASE_SYNC_APPLY,
+    PHASE_RTC_SEND,         /* arg: scheduled delay, ms */
+    PHASE_RTC_ACK,          /* arg: enum RtcLinkState */
+    PHASE_SYNC_DONE,
+    PHASE_SYNC_FAILED,
+    PHASE_UI_SYNCED,        /* The synced screen is up */
+    PHASE_COUNT
+};
+
+struct PhaseEvent
+{
+    uint64_t us;            /* timebaseUs() */
+    uint16_t phase;         /* enum Phase */
+    uint16_t arg;
+};
+
+/**
+ * @brief Records PHASE_BOOT and the RTC time it happened at. Call right after
+ * timebaseInit().
+ */
+void phaseInit(void);
+
+/**
+ * @brief Timestamps a phase. Cheap enough for the packet path: one timer
+ * read and a store.
+ */
+void phaseMark(enum Phase phase, uint16_t arg);
+
+/**
+ * @brief Events still in the buffer, oldest first. `i` is below phaseCount().
+ */
+size_t phaseCount(void);
+const struct PhaseEvent * phaseGet(size_t i);
+
+const char * phaseName(enum Phase phase);
+
+/**
+ * @brief Time from the last `from` to the first `to` after it. Returns false
+ * if there is no such pair.
+ */
+bool phaseSpanUs(enum Phase from, enum Phase to, uint64_t * pUs);
+
+/**
+ * @brief Where the time went in the last sync, one phase per line, leaving out
+ * phases that didn't happen. Fits the DS console. Returns what snprintf()
+ * would.
+ */
+size_t phaseFormatBreakdown(char * pBuffer, size_t size);
+
+/**
+ * @brief Prints phaseFormatBreakdown().
+ */
+void phasePrintBreakdown(void);
+
+/**
+ * @brief Appends the events recorded since the last call to PHASE_FILE, one
+ * CSV row each. Rows from one boot share the boot time in the first column.
+ */
+bool phaseSave(void);
+
+#endif  /* ifndef PHASE_H_ */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef RETRY_H_
+#define RETRY_H_
+
+#include <stdint.h>
+
+/* Response timeout before we have measured anything. */
+#define RETRY_INITIAL_TIMEOUT_MS    1000
+#define RETRY_MIN_TIMEOUT_MS        250
+#define RETRY_MAX_TIMEOUT_MS        4000
+
+/* Wait before the first retry. It doubles with every failure in a row. */
+#define RETRY_BACKOFF_BASE_MS       250
+#define RETRY_BACKOFF_MAX_MS        8000
+
+/* Least wait after a server sent a RATE kiss-o'-death. */
+#define RETRY_RATE_LIMITED_MS       4000
+
+/* Round trip estimate and failure count, used to pick timeouts and retry
+ * delays. Kept across syncs so a re-sync starts from what the last one saw.
+ */
+struct RetryState
+{
+    uint32_t srttMs;        /* Smoothed round trip time, 0 until measured */
+    uint32_t rttvarMs;      /* Its mean deviation */
+    uint32_t failures;      /* Failed requests in a row */
+};
+
+void retryInit(struct RetryState * pRetry);
+
+/**
+ * @brief Feeds a measured round trip into the estimate (RFC 6298) and clears
+ * the failure count.
+ */
+void retrySample(struct RetryState * pRetry, uint32_t rttMs);
+
+/**
+ * @brief How long to wait for a response: SRTT + 4 * RTTVAR, doubled for
+ * every failure in a row, within RETRY_MIN_TIMEOUT_MS..RETRY_MAX_TIMEOUT_MS.
+ */
+uint32_t retryTimeoutMs(const struct RetryState * pRetry);
+
+/**
+ * @brief Counts a failed request and returns how long to wait before the
+ * next one: exponential backoff with jitter, so consoles that failed together
+ * don't retry together. `minMs` raises the floor, e.g. after a RATE kiss-o'-
+ * death.
+ */
+uint32_t retryFailed(struct RetryState * pRetry, uint32_t minMs);
+
+#endif  /* ifndef RETRY_H_ */
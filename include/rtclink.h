@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef RTCLINK_H_
+#define RTCLINK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <nds/system.h>
+
+/* How long to wait for the ARM7 to answer a write, on top of the delay it was
+ * scheduled with. It normally takes well under a frame; anything near this
+ * means the ARM7 isn't listening. */
+#define RTCLINK_TIMEOUT_MS  250
+
+enum RtcLinkState
+{
+    RTCLINK_IDLE,
+    RTCLINK_PENDING,    /* sent, waiting for the ARM7 */
+    RTCLINK_DONE,       /* the RTC reads back what was sent */
+    RTCLINK_FAILED,     /* the ARM7 couldn't write the RTC */
+    RTCLINK_MISMATCH,   /* written, but the RTC reads back something else */
+    RTCLINK_TIMEOUT     /* no answer from the ARM7 */
+};
+
+/* One RTC write sent to the ARM7. */
+struct RtcLinkWrite
+{
+    enum RtcLinkState state;
+    uint32_t seq;
+    rtcTimeAndDate time;        /* What we asked for */
+    rtcTimeAndDate readback;    /* What the RTC held after the write */
+    uint32_t delayUs;           /* How long after arriving it was written */
+    uint64_t sentUs;            /* timebaseUs() when it was sent */
+    uint64_t answerUs;          /* ...and when the answer came */
+    uint32_t rttUs;             /* answerUs - sentUs, less the delay */
+};
+
+/* Round trip times of the ARM9 to ARM7 path since startup, not counting the
+ * delays writes were scheduled with. */
+struct RtcLinkStats
+{
+    uint32_t numOfWrites;
+    uint32_t numOfAcks;         /* Answered, whether or not the write worked */
+    uint32_t numOfTimeouts;
+    uint32_t lastRttUs;
+    uint32_t minRttUs;
+    uint32_t maxRttUs;
+};
+
+/**
+ * @brief Sends `pTime` to the ARM7 to be written to the RTC `delayUs` after
+ * it gets there (at most NDSNTP_RTC_MAX_DELAY_US). Returns NULL if an earlier
+ * write is still waiting for its answer. Call rtclinkPoll() until the state
+ * is no longer RTCLINK_PENDING.
+ *
+ * The write, and the restart of the ARM7 second tick with it, happened
+ * between sentUs + delayUs and answerUs.
+ */
+const struct RtcLinkWrite * rtclinkWriteAsync(const rtcTimeAndDate * pTime,
+                                              uint32_t delayUs);
+
+/**
+ * @brief Picks up the ARM7's answer, if there is one, and times the write
+ * out after RTCLINK_TIMEOUT_MS. Answers to writes that already timed out are
+ * dropped.
+ */
+void rtclinkPoll(void);
+
+/**
+ * @brief Blocking version of rtclinkWriteAsync(). Yields to other threads
+ * while it waits. Returns NULL if an earlier write is still pending.
+ */
+const struct RtcLinkWrite * rtclinkWrite(const rtcTimeAndDate * pTime,
+                                         uint32_t delayUs);
+
+/**
+ * @brief The last write, pending or not.
+ */
+const struct RtcLinkWrite * rtclinkLast(void);
+
+const struct RtcLinkStats * rtclinkStats(void);
+
+#endif  /* ifndef RTCLINK_H_ */
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef SCREEN_H_
+#define SCREEN_H_
+
+/* Retained-mode drawing on the text console. A menu writes its whole screen
+ * into a buffer every frame, between screenBegin() and screenEnd(), and only
+ * the characters that differ from what is already shown are sent to the
+ * console. A screen that didn't change costs a memcmp().
+ */
+
+#include <stdbool.h>
+#include <nds.h>
+
+#define SCREEN_COLS     32
+#define SCREEN_ROWS     24
+
+/**
+ * @brief Draws on `pConsole` from now on. Anything already on it is cleared
+ * by the first screenEnd().
+ */
+void screenInit(PrintConsole * pConsole);
+
+/**
+ * @brief Starts a frame with a blank buffer and the cursor at the top left.
+ */
+void screenBegin(void);
+
+/**
+ * @brief Moves the cursor. Rows and columns count from 0.
+ */
+void screenAt(int row, int col);
+
+/**
+ * @brief printf() into the buffer. Lines longer than SCREEN_COLS wrap, and
+ * anything below the last row is dropped. Escape sequences are not
+ * understood; use screenAt().
+ */
+void screenPrintf(const char * format, ...)
+    __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Puts on the console whatever changed since the last frame.
+ */
+void screenEnd(void);
+
+/**
+ * @brief Forgets what is on the console, so the next screenEnd() clears it and
+ * draws everything. Call after printing to the console directly.
+ */
+void screenInvalidate(void);
+
+#endif  /* ifndef SCREEN_H_ */
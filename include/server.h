@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef SERVER_H_
+#define SERVER_H_
+
+/* A small NTP server (RFC 5905 mode 4), so that once one console is synced the
+ * others on the same AP can sync from it instead of going out to the pool.
+ *
+ * The reply is laid out once, when serving starts; per request only the
+ * version, poll, the three timestamps and the MAC are written into it, and it
+ * goes out from the same static buffer. Requests with a MAC are answered
+ * signed, or with a crypto-NAK if the MAC doesn't check out; requests without
+ * one are answered unsigned.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Datagrams handled per serverPoll(), so a flood can't starve the menus. */
+#define SERVER_MAX_READS    16
+/* We don't learn the stratum of the server we synced from. Pool servers are
+ * mostly at 2. */
+#define SERVER_STRATUM      3
+
+struct ServerStats
+{
+    uint32_t numOfRequests;     /* Client requests, answered or not */
+    uint32_t numOfReplies;
+    uint32_t numOfIgnored;      /* Datagrams that weren't client requests */
+    uint32_t numOfNaks;         /* Requests whose MAC failed */
+    uint32_t perSecond;         /* Requests per second, over the last second */
+    uint32_t peakPerSecond;
+};
+
+/**
+ * @brief Opens `port` on every interface and starts answering. `refId` is the
+ * IPv4 address we synced from, host byte order, and `rootDelayMs` the round
+ * trip to it. Call it right after a sync: the reference time is now. Returns
+ * false if the port can't be had.
+ */
+bool serverStart(uint16_t port, uint32_t refId, uint32_t rootDelayMs);
+
+/**
+ * @brief Answers whatever requests have arrived, without waiting. Call it
+ * every frame; a packet arriving wakes the ARM9 through the FIFO.
+ */
+void serverPoll(void);
+
+/**
+ * @brief Whether serverStart() succeeded and serverStop() hasn't been called.
+ */
+bool serverRunning(void);
+
+void serverStop(void);
+
+/**
+ * @brief Counts since serverStart().
+ */
+const struct ServerStats * serverStats(void);
+
+#endif  /* ifndef SERVER_H_ */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef STORAGE_H_
+#define STORAGE_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Where ndsntp keeps its files on the SD card (or flashcart). */
+#ifndef NDSNTP_DIR
+#define NDSNTP_DIR      "/_nds/ndsntp/"
+#endif
+
+/**
+ * @brief Mounts the filesystem and creates NDSNTP_DIR if needed. Returns false
+ * if there is no usable storage; ndsntp works without it.
+ */
+bool storageInit(void);
+
+/**
+ * @brief Returns true if storageInit() succeeded.
+ */
+bool storageAvailable(void);
+
+/**
+ * @brief fopen() for a file inside NDSNTP_DIR. Returns NULL if storage is not
+ * available.
+ */
+FILE * storageOpen(const char * name, const char * mode);
+
+#endif  /* ifndef STORAGE_H_ */
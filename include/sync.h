@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef SYNC_H_
+#define SYNC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fanout.h"
+
+/* Configuration constants for the SNTP client. */
+#define NTP_TIMEOUT						3000
+#define NTP_SEND_WAIT_TIME_MS 			2000
+#define NTP_RECEIVE_WAIT_TIME_MS		1000
+
+#define SYNC_MAX_SERVERS				4
+#define SYNC_DEFAULT_RETRIES			5
+
+/* Samples taken per sync, and the pause between them. */
+#define SYNC_DEFAULT_BURST				4
+#define SYNC_BURST_SPACING_MS			500
+
+/* Longest wait for a broadcast. Servers send one every 64 s by default. */
+#define SYNC_BROADCAST_WAIT_MS			70000
+
+enum SyncMode {
+	SYNC_SEQUENTIAL,	// coreSNTP, one address of one server at a time
+	SYNC_FANOUT,		// every address of every server at once
+	SYNC_BROADCAST		// listen for the first server's broadcasts, see broadcast.h
+};
+
+struct SyncConfig {
+	enum SyncMode mode;
+	const char * servers[SYNC_MAX_SERVERS];
+	size_t numOfServers;
+	uint16_t port;		// Only changed for test servers on the host build
+	size_t bestOf;		// Fan-out: valid responses to wait for, 1 takes the first
+	size_t burst;		// Samples per sync; the one with the lowest delay is used
+	uint32_t timeoutMs;	// Longest wait for a response, 0 leaves it to retry.c
+	uint16_t broadcastPort;		// Broadcast mode: where broadcasts arrive
+	int32_t broadcastDelayMs;	// ...and how long they take, -1 measures it
+};
+
+extern struct SyncConfig syncConfig;
+
+/* A sync is a task that moves through these states. syncStep() advances it as
+ * far as it can without blocking, so the UI keeps running during the exchange.
+ */
+enum SyncState {
+	SYNC_IDLE,
+	SYNC_RESOLVE,		// Waiting for DNS, the clock anchor and any RTC write
+	SYNC_SEND,
+	SYNC_AWAIT,			// Waiting for the response(s)
+	SYNC_BACKOFF,		// Waiting to retry after a failed request
+	SYNC_PAUSE,			// Waiting to take the next sample of the burst
+	SYNC_APPLY,			// Starting the RTC write
+	SYNC_COMMIT,		// Waiting for the ARM7 to confirm it
+	SYNC_DONE,
+	SYNC_FAILED,
+	SYNC_CANCELLED
+};
+
+struct SyncProgress {
+	enum SyncState state;
+	int attempt;		// Current request, from 0
+	int retries;
+	int samples;		// Responses received so far
+	int64_t offsetMs;	// Clock offset of the best sample
+	int64_t delayMs;	// ...and its delay
+	int64_t spreadMs;	// Largest minus smallest offset of all samples
+	uint64_t startUs;	// timebaseUs() when the sync started
+	uint64_t sampledUs;	// ...when it had its samples and began writing the RTC
+	uint64_t endUs;		// ...and when it reached DONE, FAILED or CANCELLED
+};
+
+/* Start a sync. Any sync in progress is cancelled first. */
+void syncStart(int retries);
+
+/* Advance the sync. Never blocks. Returns the new state. */
+enum SyncState syncStep(void);
+
+/* Interrupts worth waking up for before the next syncStep(): the VBlank, and
+ * the FIFO while a response or the ARM7's answer to the RTC write is expected.
+ */
+uint32_t syncWaitIrq(void);
+
+void syncCancel(void);
+
+/* Close the session the first sync opened: its sockets and coreSNTP context.
+ * Call it once on exit, or after changing syncConfig; the next sync opens a
+ * new one.
+ */
+void syncShutdown(void);
+
+const struct SyncProgress * syncProgress(void);
+
+const char * syncStateName(enum SyncState state);
+
+/* Run a whole sync, sleeping between steps. Returns 0 on success. */
+int syncTime(int retries);
+
+/* Results of the last fan-out sync, including the latency of each server. */
+const struct Fanout * syncLastFanout(void);
+
+#endif  /* ifndef SYNC_H_ */
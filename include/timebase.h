@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Hardware timer used as the sub-second clock. The next timer is cascaded
+ * onto it, so both are taken. */
+#ifndef TIMEBASE_TIMER
+#define TIMEBASE_TIMER          0
+#endif
+
+/* timebaseCalibrate() is not needed once the second edge is known this well. */
+#define TIMEBASE_GOOD_WINDOW_US 1000
+
+/**
+ * @brief Starts the hardware timer. Until the first second edge has been seen
+ * the wall clock has whole-second resolution.
+ */
+void timebaseInit(void);
+
+/**
+ * @brief Looks for the RTC second edge. The edge is known to be within the
+ * time since the previous call, so the more often this runs the better the
+ * anchor. Cheap; call it every frame.
+ */
+void timebaseUpdate(void);
+
+/**
+ * @brief Polls the clock without yielding until a second edge is pinned down
+ * to within TIMEBASE_GOOD_WINDOW_US, or `maxMs` passes. Returns true if the
+ * anchor is that good.
+ */
+bool timebaseCalibrate(uint32_t maxMs);
+
+/**
+ * @brief Non-blocking version of timebaseCalibrate() for code that runs once
+ * per frame. Once a rough anchor exists, the next edge can be predicted; if it
+ * is due within `maxSpinUs`, this polls across it and returns true when the
+ * anchor is good. Otherwise it returns right away.
+ */
+bool timebaseRefine(uint32_t maxSpinUs);
+
+/**
+ * @brief Forgets the anchor. Call it after writing the RTC, the ARM7 restarts
+ * its second tick then.
+ */
+void timebaseInvalidate(void);
+
+/**
+ * @brief Sets the anchor from outside, for when the second tick was restarted
+ * at a known moment: time() became `sec` somewhere between `earliestUs` and
+ * `latestUs` (timebaseUs() values).
+ */
+void timebaseAnchor(int64_t sec, uint64_t earliestUs, uint64_t latestUs);
+
+/**
+ * @brief Returns how far off, at most, the anchor can be, in microseconds.
+ */
+uint32_t timebaseWindowUs(void);
+
+/**
+ * @brief Microseconds since timebaseInit(). Never goes backwards.
+ */
+uint64_t timebaseUs(void);
+
+/**
+ * @brief The time() clock, in microseconds.
+ */
+int64_t timebaseUnixUs(void);
+
+#endif  /* ifndef TIMEBASE_H_ */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileContributor: Ivan Veloz, 2024
+ */
+#ifndef TZ_H_
+#define TZ_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Transition times count seconds from 2000-01-01T00:00:00Z, the earliest time
+ * the RTC can hold. A 32-bit count lasts past 2099, where the tables end. */
+#define TZ_EPOCH        946684800LL
+
+/* The zone or offset picked last, so the next boot can sync without asking. */
+#define TZ_FILE         "tz.bin"
+
+/* An offset from UTC, and what it is called. */
+struct TzType
+{
+    int32_t utcOffset;          /* Seconds, local minus UTC */
+    uint8_t isDst;
+    uint16_t abbrev;            /* Into tzAbbrevs */
+};
+
+/* A named zone: the offset at TZ_EPOCH, types[0], and every change after it.
+ * Built into the ROM by tools/tzgen.py, see tzdata.c.
+ */
+struct TzZone
+{
+    const char * name;          /* e.g. "America/New_York" */
+    const struct TzType * types;
+    const uint32_t * times;     /* Sorted, seconds since TZ_EPOCH */
+    const uint8_t * index;      /* types[index[i]] applies from times[i] */
+    uint16_t numOfTransitions;
+};
+
+extern const struct TzZone tzZones[];   /* Sorted by name */
+extern const size_t tzNumOfZones;
+extern const char tzAbbrevs[];
+
+/**
+ * @brief Looks a zone up by name. Returns NULL if it is not built in.
+ */
+const struct TzZone * tzFind(const char * name);
+
+/**
+ * @brief The offset that applies in a zone at `utcSec` (Unix time). A binary
+ * search over the zone's transitions; nothing is parsed.
+ */
+const struct TzType * tzTypeAt(const struct TzZone * pZone, int64_t utcSec);
+
+static inline const char * tzAbbrev(const struct TzType * pType)
+{
+    return &tzAbbrevs[pType->abbrev];
+}
+
+/**
+ * @brief Makes a named zone the local time. The default is UTC.
+ */
+void tzSetZone(const struct TzZone * pZone);
+
+/**
+ * @brief Makes a fixed offset from UTC the local time.
+ */
+void tzSetFixed(int32_t utcOffset);
+
+/**
+ * @brief The local zone, or NULL if a fixed offset is in use.
+ */
+const struct TzZone * tzCurrentZone(void);
+
+/**
+ * @brief Local time minus UTC at `utcSec`, in seconds.
+ */
+int32_t tzOffsetAt(int64_t utcSec);
+
+/**
+ * @brief Restores the zone or offset saved by tzSave(). Returns false, leaving
+ * the local time as it was, if there is none or it names a zone that is no
+ * longer built in.
+ */
+bool tzLoad(void);
+
+/**
+ * @brief Remembers the current zone or offset for the next boot.
+ */
+bool tzSave(void);
+
+#endif  /* ifndef TZ_H_ */
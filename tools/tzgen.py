@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# SPDX-FileContributor: Ivan Veloz, 2024
+
+"""Generates arm9/source/tzdata.c from the system's zoneinfo.
+
+Every zone becomes a list of UTC offset changes between 2000 and 2099, the
+years the DS RTC can hold, so the ARM9 only has to binary search a table. Zones
+with identical tables share one.
+
+    python3 tools/tzgen.py > arm9/source/tzdata.c
+"""
+
+import datetime
+import os
+import sys
+import zoneinfo
+
+# Seconds since 2000-01-01T00:00:00Z are stored, which is where the RTC starts.
+EPOCH = datetime.datetime(2000, 1, 1, tzinfo=datetime.timezone.utc)
+END = datetime.datetime(2100, 1, 1, tzinfo=datetime.timezone.utc)
+
+ZONES = """
+Africa/Cairo Africa/Johannesburg Africa/Lagos Africa/Nairobi Africa/Casablanca
+America/Anchorage America/Argentina/Buenos_Aires America/Bogota
+America/Caracas America/Chicago America/Denver America/Halifax
+America/Havana America/Lima America/Los_Angeles America/Mexico_City
+America/New_York America/Phoenix America/Santiago America/Sao_Paulo
+America/St_Johns America/Toronto America/Vancouver
+Asia/Baghdad Asia/Bangkok Asia/Dhaka Asia/Dubai Asia/Hong_Kong Asia/Jakarta
+Asia/Jerusalem Asia/Kabul Asia/Karachi Asia/Kathmandu Asia/Kolkata
+Asia/Manila Asia/Seoul Asia/Shanghai Asia/Singapore Asia/Taipei Asia/Tehran
+Asia/Tokyo Asia/Yangon Atlantic/Azores Atlantic/Reykjavik
+Australia/Adelaide Australia/Brisbane Australia/Darwin Australia/Perth
+Australia/Sydney Europe/Amsterdam Europe/Athens Europe/Berlin Europe/Dublin
+Europe/Helsinki Europe/Istanbul Europe/Lisbon Europe/London Europe/Madrid
+Europe/Moscow Europe/Paris Europe/Rome Europe/Stockholm Europe/Warsaw
+Pacific/Auckland Pacific/Chatham Pacific/Fiji Pacific/Guam Pacific/Honolulu
+Pacific/Kiritimati Pacific/Pago_Pago Pacific/Tongatapu UTC
+""".split()
+
+
+def version():
+    for d in zoneinfo.TZPATH:
+        try:
+            with open(os.path.join(d, "tzdata.zi")) as f:
+                return f.readline().split()[-1]
+        except OSError:
+            pass
+    return "unknown"
+
+
+def state(zone, t):
+    local = t.astimezone(zone)
+    return (int(local.utcoffset().total_seconds()),
+            1 if local.dst() else 0,
+            local.tzname())
+
+
+def transitions(zone):
+    """Yields (seconds since EPOCH, state) for every change of offset."""
+    step = datetime.timedelta(hours=6)
+    t, last = EPOCH, state(zone, EPOCH)
+    while t < END:
+        n = t + step
+        s = state(zone, n)
+        if s != last:
+            lo, hi = t, n       # Changes somewhere in (lo, hi]
+            while hi - lo > datetime.timedelta(seconds=1):
+                mid = lo + (hi - lo) / 2
+                mid = mid.replace(microsecond=0)
+                if state(zone, mid) == last:
+                    lo = mid
+                else:
+                    hi = mid
+            yield int((hi - EPOCH).total_seconds()), s
+            last = s
+        t = n
+
+
+def main():
+    abbrevs = {}        # abbreviation -> offset in the string table
+    abbrevText = []
+    tables = {}         # (initial, transitions) -> table number
+    zones = []
+
+    def abbrev(a):
+        if a not in abbrevs:
+            abbrevs[a] = sum(len(x) + 1 for x in abbrevText)
+            abbrevText.append(a)
+        return abbrevs[a]
+
+    for name in sorted(ZONES):
+        zone = zoneinfo.ZoneInfo(name)
+        initial = state(zone, EPOCH)
+        key = (initial, tuple(transitions(zone)))
+        if key not in tables:
+            tables[key] = len(tables)
+        zones.append((name, tables[key]))
+
+    out = sys.stdout.write
+    out("/*\n"
+        " * Copyright (C) 2024 Ivan Veloz.  All Rights Reserved.\n"
+        " *\n"
+        " * SPDX-License-Identifier: MIT\n"
+        " * SPDX-FileContributor: Ivan Veloz, 2024\n"
+        " */\n"
+        "/* Generated by tools/tzgen.py from tzdata %s. Do not edit. */\n"
+        % version() +
+        "#include \"tz.h\"\n\n")
+
+    for (initial, trans), n in sorted(tables.items(), key=lambda x: x[1]):
+        types = [initial]
+        for _, s in trans:
+            if s not in types:
+                types.append(s)
+        out("static const struct TzType types%u[] = {\n" % n)
+        for off, dst, a in types:
+            abbrev(a)
+            out("    { %6i, %u, %3u },   /* %s */\n" % (off, dst, abbrevs[a], a))
+        out("};\n")
+        if trans:
+            out("static const uint32_t times%u[] = {" % n)
+            for i, (t, _) in enumerate(trans):
+                out(("\n    " if i % 6 == 0 else " ") + "%10u," % t)
+            out("\n};\n")
+            out("static const uint8_t index%u[] = {" % n)
+            for i, (_, s) in enumerate(trans):
+                out(("\n    " if i % 16 == 0 else " ") + "%u," % types.index(s))
+            out("\n};\n")
+        out("\n")
+
+    out("const char tzAbbrevs[] =\n")
+    for a in abbrevText:
+        out("    \"%s\\0\"\n" % a)
+    out("    ;\n\n")
+
+    sizes = {n: len(trans) for (_, trans), n in tables.items()}
+    out("const struct TzZone tzZones[] = {\n")
+    for name, n in zones:
+        if sizes[n]:
+            out("    { \"%s\", types%u, times%u, index%u, %u },\n"
+                % (name, n, n, n, sizes[n]))
+        else:
+            out("    { \"%s\", types%u, NULL, NULL, 0 },\n" % (name, n))
+    out("};\n\n")
+    out("const size_t tzNumOfZones = sizeof(tzZones) / sizeof(tzZones[0]);\n")
+
+
+if __name__ == "__main__":
+    main()